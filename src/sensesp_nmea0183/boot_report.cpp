@@ -0,0 +1,64 @@
+#include "boot_report.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+BootReport::Entry* BootReport::find(const char* name, bool event) {
+  for (size_t i = 0; i < size_; i++) {
+    if (entries_[i].event == event && strcmp(entries_[i].name, name) == 0) {
+      return &entries_[i];
+    }
+  }
+  return nullptr;
+}
+
+void BootReport::add_phase(const char* name, uint32_t duration_us) {
+  Entry* entry = find(name, false);
+  if (entry == nullptr) {
+    if (size_ >= kMaxEntries) {
+      return;
+    }
+    entry = &entries_[size_++];
+    *entry = {name, false, 0, 0};
+  }
+  entry->count++;
+  entry->us += duration_us;
+}
+
+void BootReport::mark(const char* name) {
+  if (find(name, true) != nullptr || size_ >= kMaxEntries) {
+    return;
+  }
+  entries_[size_++] = {name, true, 1, (uint32_t)micros()};
+}
+
+void BootReport::log() {
+  for (size_t i = 0; i < size_; i++) {
+    const Entry& entry = entries_[i];
+    if (entry.event) {
+      ESP_LOGI("SensESP/NMEA0183", "Boot: %s at %u ms", entry.name,
+               (unsigned)(entry.us / 1000));
+    } else {
+      ESP_LOGI("SensESP/NMEA0183", "Boot: %s took %u us (%u times)",
+               entry.name, (unsigned)entry.us, entry.count);
+    }
+  }
+}
+
+uint32_t BootReport::get_phase_us(const char* name) {
+  Entry* entry = find(name, false);
+  return entry == nullptr ? 0 : entry->us;
+}
+
+unsigned int BootReport::get_phase_count(const char* name) {
+  Entry* entry = find(name, false);
+  return entry == nullptr ? 0 : entry->count;
+}
+
+uint32_t BootReport::get_event_us(const char* name) {
+  Entry* entry = find(name, true);
+  return entry == nullptr ? 0 : entry->us;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,66 @@
+#ifndef SENSESP_NMEA0183_BOOT_REPORT_H_
+#define SENSESP_NMEA0183_BOOT_REPORT_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Where the time between power-on and the first data goes.
+ *
+ * Records the time spent in named startup phases, such as each Connect*
+ * wiring helper or the creation of lazy Signal K outputs, and the time since
+ * boot of one-off events such as the first parsed sentence. Repeated phases
+ * with the same name are summed. Entries are kept in a fixed table; names
+ * must be string literals or otherwise outlive the report.
+ */
+class BootReport {
+ public:
+  /// Most distinct phases and events recorded
+  static constexpr size_t kMaxEntries = 24;
+
+  /// Add duration_us to the phase name
+  static void add_phase(const char* name, uint32_t duration_us);
+  /// Record the time since boot of the first occurrence of event name
+  static void mark(const char* name);
+
+  /// Log one line per phase and event
+  static void log();
+  static void clear() { size_ = 0; }
+
+  /// Total time of phase name in microseconds, or 0
+  static uint32_t get_phase_us(const char* name);
+  /// Number of times phase name was added
+  static unsigned int get_phase_count(const char* name);
+  /// Time since boot of event name in microseconds, or 0
+  static uint32_t get_event_us(const char* name);
+
+ protected:
+  struct Entry {
+    const char* name;
+    bool event;
+    unsigned int count;
+    uint32_t us;
+  };
+
+  static Entry* find(const char* name, bool event);
+
+  static inline Entry entries_[kMaxEntries];
+  static inline size_t size_ = 0;
+};
+
+/// Adds the time from its construction to its destruction to a BootReport
+/// phase
+class BootPhase {
+ public:
+  BootPhase(const char* name) : name_{name}, start_us_{(uint32_t)micros()} {}
+  ~BootPhase() { BootReport::add_phase(name_, (uint32_t)micros() - start_us_); }
+
+ private:
+  const char* name_;
+  uint32_t start_us_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_BOOT_REPORT_H_
@@ -0,0 +1,90 @@
+#ifndef SENSESP_NMEA0183_FIXED_STRING_H_
+#define SENSESP_NMEA0183_FIXED_STRING_H_
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief A string from a fixed vocabulary.
+ *
+ * Holds a pointer to a string with static storage duration, such as an entry
+ * of gnss_quality_strings, so copying one never allocates.
+ */
+class InternedString {
+ public:
+  constexpr InternedString(const char* s = "") : s_{s} {}
+
+  const char* c_str() const { return s_; }
+  operator String() const { return String(s_); }
+
+  bool operator==(const InternedString& other) const {
+    return s_ == other.s_ || strcmp(s_, other.s_) == 0;
+  }
+  bool operator!=(const InternedString& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  const char* s_;
+};
+
+/**
+ * @brief A string of at most N characters stored inline.
+ *
+ * Used for identifiers, such as waypoint IDs, that are parsed from every
+ * sentence and would otherwise allocate a String each time.
+ */
+template <size_t N>
+class FixedString {
+ public:
+  FixedString() { buf_[0] = 0; }
+  FixedString(const char* s) { assign(s); }
+
+  /// Copy s. Returns false if s was truncated to N characters.
+  bool assign(const char* s) {
+    size_t length = strnlen(s, N + 1);
+    bool fits = length <= N;
+    if (!fits) {
+      length = N;
+    }
+    memcpy(buf_, s, length);
+    buf_[length] = 0;
+    length_ = length;
+    return fits;
+  }
+
+  static constexpr size_t capacity() { return N; }
+  size_t length() const { return length_; }
+  const char* c_str() const { return buf_; }
+  operator String() const { return String(buf_); }
+
+  bool operator==(const FixedString& other) const {
+    return length_ == other.length_ && memcmp(buf_, other.buf_, length_) == 0;
+  }
+  bool operator!=(const FixedString& other) const { return !(*this == other); }
+  bool operator==(const char* other) const { return strcmp(buf_, other) == 0; }
+
+ private:
+  char buf_[N + 1];
+  size_t length_ = 0;
+};
+
+/// Longest waypoint or route ID accepted by the parsers
+constexpr size_t kMaxWaypointIDLength = 20;
+using WaypointID = FixedString<kMaxWaypointIDLength>;
+
+inline bool convertToJson(const InternedString& value, JsonVariant& dst) {
+  return dst.set(value.c_str());
+}
+
+template <size_t N>
+bool convertToJson(const FixedString<N>& value, JsonVariant& dst) {
+  return dst.set(value.c_str());
+}
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_FIXED_STRING_H_
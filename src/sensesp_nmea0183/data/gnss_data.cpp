@@ -6,45 +6,215 @@
 
 namespace sensesp::nmea0183 {
 
+const char* GNSSSystemName(GNSSSystem system) {
+  switch (system) {
+    case GNSSSystem::gps:
+      return "GPS";
+    case GNSSSystem::glonass:
+      return "GLONASS";
+    case GNSSSystem::galileo:
+      return "Galileo";
+    case GNSSSystem::beidou:
+      return "Beidou";
+    case GNSSSystem::qzss:
+      return "QZSS";
+    case GNSSSystem::sbas:
+      return "SBAS";
+    case GNSSSystem::irnss:
+      return "IRNSS";
+    default:
+      return "Unknown";
+  }
+}
+
 bool convertToJson(const GNSSSystem& value, JsonVariant& dst) {
-  switch (value) {
+  return dst.set(GNSSSystemName(value));
+}
+
+// Names and IDs below copied from this document:
+// https://docs.fixposition.com/fd/nmea-gp-gsv
+
+const char* GNSSSignalName(GNSSSystem system, uint8_t signal_id) {
+  if (signal_id == kGNSSSatelliteNoSignal) {
+    return "";
+  }
+  switch (system) {
     case GNSSSystem::gps:
-      dst.set("GPS");
+      switch (signal_id) {
+        case 1:
+          return "GPS L1 C/A";
+        case 6:
+          return "GPS L2C-L";
+      }
       break;
     case GNSSSystem::glonass:
-      dst.set("GLONASS");
+      switch (signal_id) {
+        case 1:
+          return "GLONASS G1 C/A";
+        case 3:
+          return "GLONASS G2 C/A";
+      }
       break;
     case GNSSSystem::galileo:
-      dst.set("Galileo");
+      switch (signal_id) {
+        case 7:
+          return "Galileo L1-BC";
+        case 2:
+          return "Galileo E5b";
+      }
       break;
     case GNSSSystem::beidou:
-      dst.set("Beidou");
-      break;
-    case GNSSSystem::qzss:
-      dst.set("QZSS");
-      break;
-    case GNSSSystem::sbas:
-      dst.set("SBAS");
-      break;
-    case GNSSSystem::irnss:
-      dst.set("IRNSS");
+      switch (signal_id) {
+        case 1:
+          return "Beidou B1I";
+        case 0xB:
+          return "Beidou B2I";
+      }
       break;
     default:
-      dst.set("Unknown");
       break;
   }
+  return "unknown";
+}
+
+GNSSSatelliteTable& GNSSSatelliteTable::operator=(
+    const GNSSSatelliteTable& other) {
+  if (this == &other) {
+    return *this;
+  }
+  size_ = other.size_;
+  memcpy(id_, other.id_, size_ * sizeof(id_[0]));
+  memcpy(azimuth_, other.azimuth_, size_ * sizeof(azimuth_[0]));
+  memcpy(system_, other.system_, size_ * sizeof(system_[0]));
+  memcpy(elevation_, other.elevation_, size_ * sizeof(elevation_[0]));
+  memcpy(snr_, other.snr_, size_ * sizeof(snr_[0]));
+  memcpy(signal_id_, other.signal_id_, size_ * sizeof(signal_id_[0]));
+  return *this;
+}
+
+bool GNSSSatelliteTable::push_back(const GNSSSatellite& satellite) {
+  if (size_ >= kMaxGNSSSatellites) {
+    return false;
+  }
+  id_[size_] = satellite.id;
+  azimuth_[size_] = satellite.azimuth;
+  system_[size_] = satellite.system;
+  elevation_[size_] = satellite.elevation;
+  snr_[size_] = satellite.snr;
+  signal_id_[size_] = satellite.signal_id;
+  size_++;
   return true;
 }
 
+GNSSSatellite GNSSSatelliteTable::operator[](size_t i) const {
+  GNSSSatellite satellite;
+  satellite.id = id_[i];
+  satellite.azimuth = azimuth_[i];
+  satellite.system = system_[i];
+  satellite.elevation = elevation_[i];
+  satellite.snr = snr_[i];
+  satellite.signal_id = signal_id_[i];
+  return satellite;
+}
+
+/// Fill obj from the compact fields; unreported values become null.
+static void SatelliteToJson(JsonObject& obj, GNSSSystem system, uint16_t id,
+                            int8_t elevation, uint16_t azimuth, uint8_t snr,
+                            uint8_t signal_id) {
+  obj["system"] = system;
+  if (id != kGNSSSatelliteNoID) {
+    obj["id"] = id;
+  } else {
+    obj["id"] = nullptr;
+  }
+  if (elevation != kGNSSSatelliteNoElevation) {
+    obj["elevation"] = elevation;
+  } else {
+    obj["elevation"] = nullptr;
+  }
+  if (azimuth != kGNSSSatelliteNoAzimuth) {
+    obj["azimuth"] = azimuth;
+  } else {
+    obj["azimuth"] = nullptr;
+  }
+  if (snr != kGNSSSatelliteNoSNR) {
+    obj["snr"] = snr;
+  } else {
+    obj["snr"] = nullptr;
+  }
+  obj["signal"] = GNSSSignalName(system, signal_id);
+}
+
 bool convertToJson(const GNSSSatellite& value, JsonVariant& dst) {
   JsonObject obj = dst.to<JsonObject>();
-  obj["system"] = value.system;
-  obj["id"] = value.id;
-  obj["elevation"] = value.elevation;
-  obj["azimuth"] = value.azimuth;
-  obj["snr"] = value.snr;
-  obj["signal"] = value.signal;
+  SatelliteToJson(obj, value.system, value.id, value.elevation, value.azimuth,
+                  value.snr, value.signal_id);
+  return true;
+}
+
+bool convertToJson(const GNSSSatelliteTable& value, JsonVariant& dst) {
+  JsonArray array = dst.to<JsonArray>();
+  for (size_t i = 0; i < value.size(); i++) {
+    JsonObject obj = array.add<JsonObject>();
+    SatelliteToJson(obj, value.systems()[i], value.ids()[i],
+                    value.elevations()[i], value.azimuths()[i],
+                    value.snrs()[i], value.signal_ids()[i]);
+  }
   return true;
 }
 
+bool convertToJson(const GNSSSatelliteTable* value, JsonVariant& dst) {
+  if (value == nullptr) {
+    dst.set(nullptr);
+    return true;
+  }
+  return convertToJson(*value, dst);
+}
+
+/// Write one satellite with the keys and nulls of SatelliteToJson.
+static void WriteSatelliteJson(JsonWriter& writer, GNSSSystem system,
+                               uint16_t id, int8_t elevation, uint16_t azimuth,
+                               uint8_t snr, uint8_t signal_id) {
+  writer.begin_object();
+  writer.key("system");
+  writer.value(GNSSSystemName(system));
+  writer.key("id");
+  if (id != kGNSSSatelliteNoID) {
+    writer.value(static_cast<unsigned long>(id));
+  } else {
+    writer.null();
+  }
+  writer.key("elevation");
+  if (elevation != kGNSSSatelliteNoElevation) {
+    writer.value(static_cast<long>(elevation));
+  } else {
+    writer.null();
+  }
+  writer.key("azimuth");
+  if (azimuth != kGNSSSatelliteNoAzimuth) {
+    writer.value(static_cast<unsigned long>(azimuth));
+  } else {
+    writer.null();
+  }
+  writer.key("snr");
+  if (snr != kGNSSSatelliteNoSNR) {
+    writer.value(static_cast<unsigned long>(snr));
+  } else {
+    writer.null();
+  }
+  writer.key("signal");
+  writer.value(GNSSSignalName(system, signal_id));
+  writer.end_object();
+}
+
+void WriteJson(const GNSSSatelliteTable& value, JsonWriter& writer) {
+  writer.begin_array();
+  for (size_t i = 0; i < value.size(); i++) {
+    WriteSatelliteJson(writer, value.systems()[i], value.ids()[i],
+                       value.elevations()[i], value.azimuths()[i],
+                       value.snrs()[i], value.signal_ids()[i]);
+  }
+  writer.end_array();
+}
+
 }  // namespace sensesp::nmea0183
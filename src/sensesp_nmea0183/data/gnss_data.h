@@ -5,13 +5,16 @@
 #include "sensesp/system/observablevalue.h"
 #include "sensesp/types/nullable.h"
 #include "sensesp/types/position.h"
+#include "sensesp_nmea0183/data/fixed_string.h"
+#include "sensesp_nmea0183/data/json_writer.h"
+#include "sensesp_nmea0183/sentence_parser/field_parsers.h"
 
 namespace sensesp::nmea0183 {
 
 /***
  * @brief Enumeration of GNSS systems, used in the GNSSSatellite struct.
  */
-enum class GNSSSystem {
+enum class GNSSSystem : uint8_t {
   unknown,
   gps,
   glonass,
@@ -22,28 +25,141 @@ enum class GNSSSystem {
   irnss,
 };
 
+// Values of the GNSSSatellite fields not reported by the receiver
+constexpr uint16_t kGNSSSatelliteNoID = 0;
+constexpr uint16_t kGNSSSatelliteNoAzimuth = 0xFFFF;
+constexpr int8_t kGNSSSatelliteNoElevation = INT8_MIN;
+constexpr uint8_t kGNSSSatelliteNoSNR = 0xFF;
+/// Signal ID of a GSV sentence older than NMEA 0183 v4.10
+constexpr uint8_t kGNSSSatelliteNoSignal = 0xFF;
+
+/// Name of a GSV signal ID, interned. Empty for kGNSSSatelliteNoSignal.
+const char* GNSSSignalName(GNSSSystem system, uint8_t signal_id);
+
 /***
  * @brief Struct to hold information about a single GNSS satellite visibility.
+ *
+ * Packed into 8 bytes; angles are whole degrees as reported by GSV.
  */
 struct GNSSSatellite {
-  GNSSSystem system;
-  int id;
-  sensesp::Nullable<float> elevation;
-  sensesp::Nullable<float> azimuth;
-  int snr;
-  String signal;
+  uint16_t id = kGNSSSatelliteNoID;  // PRN
+  uint16_t azimuth = kGNSSSatelliteNoAzimuth;  // degrees from true north
+  GNSSSystem system = GNSSSystem::unknown;
+  int8_t elevation = kGNSSSatelliteNoElevation;  // degrees
+  uint8_t snr = kGNSSSatelliteNoSNR;             // dB-Hz, none if not tracked
+  uint8_t signal_id = kGNSSSatelliteNoSignal;
+
+  const char* signal() const { return GNSSSignalName(system, signal_id); }
 };
 
+/// Most satellite-signal entries kept per GSV cycle
+constexpr size_t kMaxGNSSSatellites = 192;
+
+/**
+ * @brief The satellites of one GSV cycle, stored as a structure of arrays.
+ *
+ * Capacity is fixed, so collecting and copying a cycle never allocates, and
+ * copies only move the entries in use. Entries are read back as
+ * GNSSSatellite values; serializers may read the columns directly.
+ */
+class GNSSSatelliteTable {
+ public:
+  class const_iterator {
+   public:
+    const_iterator(const GNSSSatelliteTable* table, size_t i)
+        : table_{table}, i_{i} {}
+    GNSSSatellite operator*() const { return (*table_)[i_]; }
+    const_iterator& operator++() {
+      i_++;
+      return *this;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return i_ != other.i_;
+    }
+
+   private:
+    const GNSSSatelliteTable* table_;
+    size_t i_;
+  };
+
+  GNSSSatelliteTable() = default;
+  GNSSSatelliteTable(const GNSSSatelliteTable& other) { *this = other; }
+  GNSSSatelliteTable& operator=(const GNSSSatelliteTable& other);
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  static constexpr size_t capacity() { return kMaxGNSSSatellites; }
+  void clear() { size_ = 0; }
+  /// Append a satellite. Returns false if the table is full.
+  bool push_back(const GNSSSatellite& satellite);
+  GNSSSatellite operator[](size_t i) const;
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  // Columns
+  const uint16_t* ids() const { return id_; }
+  const uint16_t* azimuths() const { return azimuth_; }
+  const GNSSSystem* systems() const { return system_; }
+  const int8_t* elevations() const { return elevation_; }
+  const uint8_t* snrs() const { return snr_; }
+  const uint8_t* signal_ids() const { return signal_id_; }
+
+ protected:
+  size_t size_ = 0;
+  uint16_t id_[kMaxGNSSSatellites];
+  uint16_t azimuth_[kMaxGNSSSatellites];
+  GNSSSystem system_[kMaxGNSSSatellites];
+  int8_t elevation_[kMaxGNSSSatellites];
+  uint8_t snr_[kMaxGNSSSatellites];
+  uint8_t signal_id_[kMaxGNSSSatellites];
+};
+
+/// Name of a GNSS system as used in Signal K
+const char* GNSSSystemName(GNSSSystem system);
+
 bool convertToJson(const GNSSSystem& value, JsonVariant& dst);
 
+/**
+ * @brief One GNSS fix, merged from all sentences reporting the same epoch.
+ *
+ * Fields not reported by any sentence of the epoch hold the kInvalid* magic
+ * values of the field parsers; datetime is -1 when unknown.
+ */
+struct GNSSFix {
+  float utc_time = kInvalidFloat;  // seconds since UTC midnight
+  Position position = {kInvalidDouble, kInvalidDouble,
+                       kPositionInvalidAltitude};
+  time_t datetime = -1;
+  int quality = kInvalidInt;  // GGA quality indicator (0-8)
+  int num_satellites = kInvalidInt;
+  int fix_type = kInvalidInt;  // GSA: 1=no fix, 2=2D, 3=3D
+  float horizontal_dilution = kInvalidFloat;
+  float pdop = kInvalidFloat;
+  float vdop = kInvalidFloat;
+  float geoidal_separation = kInvalidFloat;
+  float dgps_age = kInvalidFloat;
+  int dgps_id = kInvalidInt;
+  float speed = kInvalidFloat;        // m/s
+  float true_course = kInvalidFloat;  // radians
+  float variation = kInvalidFloat;    // radians
+  /// Bit mask of the GNSSEpochAssembler sources that contributed to the fix
+  uint8_t sources = 0;
+};
+
 /**
  * @brief Convenience container for all decoded NMEA 0183 GNSS data.
  */
 struct GNSSData {
+  /// Complete fix, emitted once per epoch. The individual members below are
+  /// updated from it.
+  ObservableValue<GNSSFix> fix;
   ObservableValue<Position> position;
-  ObservableValue<String> rtk_quality;
+  ObservableValue<InternedString> rtk_quality;
   ObservableValue<int> num_satellites;
-  ObservableValue<std::vector<GNSSSatellite>> satellites;
+  /// Satellites in view of the latest GSV cycle. Points to a table owned by
+  /// the GSVSentenceParser, valid until its next cycle is emitted.
+  ObservableValue<const GNSSSatelliteTable*> satellites{nullptr};
   ObservableValue<float> horizontal_dilution;
   ObservableValue<float> geoidal_separation;
   ObservableValue<float> dgps_age;
@@ -59,6 +175,10 @@ struct GNSSData {
 };
 
 bool convertToJson(const GNSSSatellite& value, JsonVariant& dst);
+bool convertToJson(const GNSSSatelliteTable& value, JsonVariant& dst);
+bool convertToJson(const GNSSSatelliteTable* value, JsonVariant& dst);
+/// Stream value as JSON, byte-identical to serializing convertToJson's output
+void WriteJson(const GNSSSatelliteTable& value, JsonWriter& writer);
 
 /**
  * @brief Convenience container for RTK-specific GNSS data.
@@ -67,7 +187,7 @@ struct RTKData {
   ObservableValue<Position> position;
   ObservableValue<time_t> datetime;
   ObservableValue<ENUVector> enu_velocity;
-  ObservableValue<String> rtk_quality;
+  ObservableValue<InternedString> rtk_quality;
   ObservableValue<float> rtk_age;
   ObservableValue<float> rtk_ratio;
   ObservableValue<ENUVector> baseline_projection;
@@ -0,0 +1,127 @@
+#include "json_writer.h"
+
+namespace sensesp::nmea0183 {
+
+void JsonWriter::write(const char* s, size_t length) {
+  size_ += out_.write(reinterpret_cast<const uint8_t*>(s), length);
+}
+
+void JsonWriter::separator() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (depth_ == 0) {
+    return;
+  }
+  uint32_t bit = 1UL << (depth_ - 1);
+  if (empty_ & bit) {
+    empty_ &= ~bit;
+  } else {
+    write(',');
+  }
+}
+
+void JsonWriter::begin(char c) {
+  separator();
+  write(c);
+  if (depth_ >= kMaxDepth) {
+    ok_ = false;
+    return;
+  }
+  depth_++;
+  empty_ |= 1UL << (depth_ - 1);
+}
+
+void JsonWriter::end(char c) {
+  if (depth_ > 0) {
+    empty_ &= ~(1UL << (depth_ - 1));
+    depth_--;
+  }
+  write(c);
+}
+
+void JsonWriter::key(const char* name) {
+  value(name);
+  write(':');
+  after_key_ = true;
+}
+
+void JsonWriter::value(const char* s) {
+  separator();
+  write('"');
+  const char* run = s;
+  for (; *s; s++) {
+    char escape = 0;
+    switch (*s) {
+      case '"':
+        escape = '"';
+        break;
+      case '\\':
+        escape = '\\';
+        break;
+      case '\b':
+        escape = 'b';
+        break;
+      case '\f':
+        escape = 'f';
+        break;
+      case '\n':
+        escape = 'n';
+        break;
+      case '\r':
+        escape = 'r';
+        break;
+      case '\t':
+        escape = 't';
+        break;
+    }
+    if (escape) {
+      write(run, s - run);
+      char sequence[2] = {'\\', escape};
+      write(sequence, 2);
+      run = s + 1;
+    }
+  }
+  write(run, s - run);
+  write('"');
+}
+
+void JsonWriter::value(unsigned long v) {
+  separator();
+  char buffer[20];
+  char* p = buffer + sizeof(buffer);
+  do {
+    *--p = '0' + v % 10;
+    v /= 10;
+  } while (v);
+  write(p, buffer + sizeof(buffer) - p);
+}
+
+void JsonWriter::value(long v) {
+  if (v >= 0) {
+    value(static_cast<unsigned long>(v));
+    return;
+  }
+  separator();
+  write('-');
+  // The separator is already written
+  after_key_ = true;
+  value(0UL - static_cast<unsigned long>(v));
+}
+
+void JsonWriter::value(bool v) {
+  separator();
+  if (v) {
+    write("true", 4);
+  } else {
+    write("false", 5);
+  }
+}
+
+void JsonWriter::null() {
+  separator();
+  write("null", 4);
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,130 @@
+#ifndef SENSESP_NMEA0183_JSON_WRITER_H_
+#define SENSESP_NMEA0183_JSON_WRITER_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Write compact JSON to a Print as it is produced.
+ *
+ * Emits the same bytes as serializeJson() of the equivalent ArduinoJson
+ * document, without building the document first. Scratch memory is a few
+ * bytes of stack for number formatting; nesting is tracked in a bitmask, so
+ * at most kMaxDepth levels are supported.
+ */
+class JsonWriter {
+ public:
+  static constexpr uint8_t kMaxDepth = 32;
+
+  explicit JsonWriter(Print& out) : out_{out} {}
+
+  void begin_object() { begin('{'); }
+  void end_object() { end('}'); }
+  void begin_array() { begin('['); }
+  void end_array() { end(']'); }
+
+  /// Write an object key; the next call writes its value
+  void key(const char* name);
+
+  void value(const char* s);
+  void value(long v);
+  void value(unsigned long v);
+  void value(bool v);
+  void null();
+
+  /// Bytes written so far
+  size_t size() const { return size_; }
+  /// False if nesting exceeded kMaxDepth; the output is then incomplete
+  bool ok() const { return ok_; }
+
+ protected:
+  void begin(char c);
+  void end(char c);
+  void separator();
+  void write(const char* s, size_t length);
+  void write(char c) { write(&c, 1); }
+
+  Print& out_;
+  size_t size_ = 0;
+  // Bit n is set while the container at depth n has no elements yet
+  uint32_t empty_ = 0;
+  uint8_t depth_ = 0;
+  bool after_key_ = false;
+  bool ok_ = true;
+};
+
+/// Write the value pointed to, or null for nullptr
+template <typename T>
+void WriteJson(const T* value, JsonWriter& writer) {
+  if (value == nullptr) {
+    writer.null();
+    return;
+  }
+  WriteJson(*value, writer);
+}
+
+/**
+ * @brief A Print that appends to a String.
+ *
+ * clear() keeps the allocation, so a buffer reused for every output of the
+ * same size stops allocating after the first one.
+ */
+class StringPrint : public Print {
+ public:
+  virtual size_t write(uint8_t c) override {
+    return write(&c, 1);
+  }
+  virtual size_t write(const uint8_t* buffer, size_t size) override {
+    buffer_.concat(reinterpret_cast<const char*>(buffer), size);
+    return size;
+  }
+
+  void clear() { buffer_ = ""; }
+  void reserve(size_t size) { buffer_.reserve(size); }
+  const char* c_str() const { return buffer_.c_str(); }
+  size_t length() const { return buffer_.length(); }
+  const String& str() const { return buffer_; }
+
+ protected:
+  String buffer_;
+};
+
+/**
+ * @brief A Print into a fixed buffer.
+ *
+ * Bytes that don't fit are dropped, but still counted by get_needed(), so
+ * the caller can tell how large a buffer would have been needed.
+ */
+class FixedPrint : public Print {
+ public:
+  FixedPrint(char* buffer, size_t size) : buffer_{buffer}, size_{size} {}
+
+  virtual size_t write(uint8_t c) override { return write(&c, 1); }
+  virtual size_t write(const uint8_t* buffer, size_t size) override {
+    needed_ += size;
+    size_t space = size_ - length_;
+    if (size > space) {
+      size = space;
+    }
+    memcpy(buffer_ + length_, buffer, size);
+    length_ += size;
+    return size;
+  }
+
+  const char* data() const { return buffer_; }
+  size_t length() const { return length_; }
+  /// Bytes written, including those that didn't fit
+  size_t get_needed() const { return needed_; }
+  bool overflowed() const { return needed_ > length_; }
+
+ protected:
+  char* buffer_;
+  size_t size_;
+  size_t length_ = 0;
+  size_t needed_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_JSON_WRITER_H_
@@ -0,0 +1,99 @@
+#ifndef SENSESP_NMEA0183_NAVIGATION_SNAPSHOT_H_
+#define SENSESP_NMEA0183_NAVIGATION_SNAPSHOT_H_
+
+#include <atomic>
+
+#include "sensesp/types/position.h"
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief A snapshot value with the time of its last update.
+ */
+template <typename T>
+struct SnapshotValue {
+  T value{};
+  bool valid = false;
+  uint32_t updated_ms = 0;  // millis() of the last update
+
+  /// Milliseconds since the last update
+  uint32_t age_ms(uint32_t now_ms) const { return now_ms - updated_ms; }
+
+  void set(const T& new_value, uint32_t now_ms) {
+    value = new_value;
+    valid = true;
+    updated_ms = now_ms;
+  }
+};
+
+/**
+ * @brief Latest navigation state, as copied out of a NavigationSnapshot.
+ */
+struct NavigationState {
+  uint32_t version = 0;  // Incremented on every update
+  SnapshotValue<Position> position;
+  SnapshotValue<float> speed_over_ground;        // m/s
+  SnapshotValue<float> course_over_ground_true;  // radians
+  SnapshotValue<float> heading_true;             // radians
+  SnapshotValue<float> heading_magnetic;         // radians
+  SnapshotValue<float> apparent_wind_angle;      // radians
+  SnapshotValue<float> apparent_wind_speed;      // m/s
+};
+
+/**
+ * @brief Navigation state shared with other tasks through a seqlock.
+ *
+ * Updated from the event loop by the observers ConnectNavigationSnapshot()
+ * attaches to the data containers. Any task or core may read it without
+ * locks or callbacks: read() copies the state and retries if an update
+ * raced with the copy.
+ *
+ * There must be only one writer, the event loop.
+ */
+class NavigationSnapshot {
+ public:
+  /// Copy attempts before read() gives up
+  static constexpr int kMaxReadRetries = 8;
+
+  /**
+   * @brief Copy the latest consistent state.
+   *
+   * @return false if every attempt raced with an update. This only happens
+   * if the reader preempts the writer on the same core; try again later.
+   */
+  bool read(NavigationState* state) const {
+    for (int i = 0; i < kMaxReadRetries; i++) {
+      uint32_t seq = seq_.load(std::memory_order_acquire);
+      if (seq & 1) {
+        // Update in progress
+        continue;
+      }
+      *state = state_;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) == seq) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Apply modify(NavigationState*) as one update. Event loop only.
+  template <typename F>
+  void write(F modify) {
+    uint32_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    modify(&state_);
+    state_.version++;
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+ protected:
+  // Odd while an update is in progress
+  std::atomic<uint32_t> seq_{0};
+  NavigationState state_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_NAVIGATION_SNAPSHOT_H_
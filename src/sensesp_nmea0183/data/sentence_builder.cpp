@@ -0,0 +1,243 @@
+#include "sentence_builder.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "sensesp_nmea0183/sentence_parser/field_parsers.h"
+
+namespace sensesp::nmea0183 {
+
+// Characters reserved at the end of the buffer for "*HH" and the terminator
+static constexpr size_t kChecksumReserve = 4;
+static constexpr int kMaxDecimals = 9;
+static constexpr long kSecondsPerDay = 86400;
+
+static const char kHexDigits[] = "0123456789ABCDEF";
+
+static uint64_t PowerOfTen(int exponent) {
+  uint64_t result = 1;
+  while (exponent-- > 0) {
+    result *= 10;
+  }
+  return result;
+}
+
+static bool IsValid(double value) {
+  return !isnan(value) && !isinf(value) && value != kInvalidDouble &&
+         value != static_cast<double>(kInvalidFloat);
+}
+
+static int ClampDecimals(int decimals) {
+  return decimals < 0 ? 0 : decimals > kMaxDecimals ? kMaxDecimals : decimals;
+}
+
+void SentenceBuilder::clear() {
+  length_ = 0;
+  checksum_ = 0;
+  finished_ = false;
+  ok_ = size_ >= kChecksumReserve;
+  if (size_ > 0) {
+    buffer_[0] = 0;
+  }
+}
+
+void SentenceBuilder::put(char c) {
+  if (!ok_ || finished_ || length_ + kChecksumReserve >= size_) {
+    ok_ = false;
+    return;
+  }
+  buffer_[length_++] = c;
+  buffer_[length_] = 0;
+  checksum_ ^= static_cast<uint8_t>(c);
+}
+
+void SentenceBuilder::put(const char* s, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    put(s[i]);
+  }
+}
+
+void SentenceBuilder::put_digits(uint64_t value, int width) {
+  char digits[20];
+  char* p = digits + sizeof(digits);
+  do {
+    *--p = '0' + value % 10;
+    value /= 10;
+    width--;
+  } while (value || width > 0);
+  put(p, digits + sizeof(digits) - p);
+}
+
+void SentenceBuilder::put_fixed(uint64_t value, int decimals, int int_width) {
+  uint64_t scale = PowerOfTen(decimals);
+  put_digits(value / scale, int_width);
+  if (decimals > 0) {
+    put('.');
+    put_digits(value % scale, decimals);
+  }
+}
+
+SentenceBuilder& SentenceBuilder::start(const char* address, char start_char) {
+  clear();
+  if (!ok_) {
+    return *this;
+  }
+  put(start_char);
+  // The start character is not part of the checksum
+  checksum_ = 0;
+  put(address, strlen(address));
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_empty() {
+  separator();
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_string(const char* s) {
+  separator();
+  put(s, strlen(s));
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_char(char c) {
+  separator();
+  if (c != 0) {
+    put(c);
+  }
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_int(int value) {
+  separator();
+  if (value == kInvalidInt) {
+    return *this;
+  }
+  if (value < 0) {
+    put('-');
+    put_digits(0UL - static_cast<unsigned long>(value), 1);
+  } else {
+    put_digits(value, 1);
+  }
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_float(double value, int decimals) {
+  separator();
+  if (!IsValid(value)) {
+    return *this;
+  }
+  decimals = ClampDecimals(decimals);
+  double scaled = fabs(value) * PowerOfTen(decimals) + 0.5;
+  if (scaled >= 18446744073709551615.0) {
+    ok_ = false;
+    return *this;
+  }
+  uint64_t fixed = static_cast<uint64_t>(scaled);
+  // Don't write "-0.0"
+  if (value < 0 && fixed != 0) {
+    put('-');
+  }
+  put_fixed(fixed, decimals, 1);
+  return *this;
+}
+
+void SentenceBuilder::put_degrees(double degrees, int degree_width,
+                                  int decimals, char positive, char negative) {
+  separator();
+  if (!IsValid(degrees)) {
+    separator();
+    return;
+  }
+  decimals = ClampDecimals(decimals);
+  uint64_t minute_scale = PowerOfTen(decimals);
+  // Rounding the whole value in minute units carries 59.99995' into the
+  // next degree
+  uint64_t minutes =
+      static_cast<uint64_t>(fabs(degrees) * 60 * minute_scale + 0.5);
+  put_digits(minutes / (60 * minute_scale), degree_width);
+  put_fixed(minutes % (60 * minute_scale), decimals, 2);
+  separator();
+  put(degrees < 0 ? negative : positive);
+}
+
+SentenceBuilder& SentenceBuilder::add_latitude(double degrees, int decimals) {
+  put_degrees(degrees, 2, decimals, 'N', 'S');
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_longitude(double degrees, int decimals) {
+  put_degrees(degrees, 3, decimals, 'E', 'W');
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_time(int hour, int minute, float second,
+                                           int decimals) {
+  separator();
+  if (hour < 0 || minute < 0 || !IsValid(second) || second < 0) {
+    return *this;
+  }
+  decimals = ClampDecimals(decimals);
+  uint64_t scale = PowerOfTen(decimals);
+  uint64_t day = kSecondsPerDay * scale;
+  double seconds_of_day = hour * 3600.0 + minute * 60.0 + second;
+  uint64_t time = static_cast<uint64_t>(seconds_of_day * scale + 0.5) % day;
+  uint64_t seconds = time / scale;
+  put_digits(seconds / 3600, 2);
+  put_digits(seconds / 60 % 60, 2);
+  put_fixed(time % (60 * scale), decimals, 2);
+  return *this;
+}
+
+SentenceBuilder& SentenceBuilder::add_time(time_t time, int decimals) {
+  long seconds = time % kSecondsPerDay;
+  if (seconds < 0) {
+    seconds += kSecondsPerDay;
+  }
+  return add_time(seconds / 3600, seconds / 60 % 60, seconds % 60, decimals);
+}
+
+SentenceBuilder& SentenceBuilder::add_date(time_t time) {
+  separator();
+  // Civil date from days since the epoch, after Howard Hinnant's
+  // civil_from_days algorithm
+  long days = time / kSecondsPerDay;
+  if (time % kSecondsPerDay < 0) {
+    days--;
+  }
+  days += 719468;
+  long era = (days >= 0 ? days : days - 146096) / 146097;
+  unsigned long day_of_era = days - era * 146097;
+  unsigned long year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 -
+       day_of_era / 146096) /
+      365;
+  unsigned long day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  unsigned long mp = (5 * day_of_year + 2) / 153;
+  unsigned long day = day_of_year - (153 * mp + 2) / 5 + 1;
+  unsigned long month = mp < 10 ? mp + 3 : mp - 9;
+  long year = year_of_era + era * 400 + (month <= 2);
+  put_digits(day, 2);
+  put_digits(month, 2);
+  put_digits(year % 100, 2);
+  return *this;
+}
+
+const char* SentenceBuilder::finish() {
+  if (!ok_ || length_ == 0) {
+    return nullptr;
+  }
+  if (finished_) {
+    return buffer_;
+  }
+  // Space for these was reserved by put()
+  buffer_[length_++] = '*';
+  buffer_[length_++] = kHexDigits[checksum_ >> 4];
+  buffer_[length_++] = kHexDigits[checksum_ & 0x0F];
+  buffer_[length_] = 0;
+  finished_ = true;
+  return buffer_;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,88 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_BUILDER_H_
+#define SENSESP_NMEA0183_SENTENCE_BUILDER_H_
+
+#include <Arduino.h>
+#include <time.h>
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Write an NMEA 0183 sentence into a fixed buffer.
+ *
+ * Fields are appended one at a time, each preceded by a comma, and the
+ * checksum is updated as the characters are written. finish() appends the
+ * checksum and returns the 0-terminated sentence, without line ending,
+ * ready for NMEA0183IO::write(). Nothing is allocated.
+ *
+ * Numbers are formatted with integer arithmetic. Values that are NaN or
+ * one of the kInvalid* magic values are written as empty fields.
+ *
+ * If the buffer is too small, the builder stops writing, ok() returns false
+ * and finish() returns nullptr.
+ *
+ *   char buffer[83];
+ *   SentenceBuilder sentence(buffer, sizeof(buffer));
+ *   sentence.start("IIHDT");
+ *   sentence.add_float(98.3, 1);
+ *   sentence.add_char('T');
+ *   io->write(sentence.finish());
+ */
+class SentenceBuilder {
+ public:
+  SentenceBuilder(char* buffer, size_t size) : buffer_{buffer}, size_{size} {
+    clear();
+  }
+
+  /// Begin a sentence with this address field, e.g. "GPRMC"
+  SentenceBuilder& start(const char* address, char start_char = '$');
+
+  SentenceBuilder& add_empty();
+  SentenceBuilder& add_string(const char* s);
+  SentenceBuilder& add_char(char c);
+  SentenceBuilder& add_int(int value);
+  /// Value with a fixed number of decimals, e.g. "98.30"
+  SentenceBuilder& add_float(double value, int decimals);
+  /// Two fields: ddmm.mmmm and N or S
+  SentenceBuilder& add_latitude(double degrees, int decimals = 4);
+  /// Two fields: dddmm.mmmm and E or W
+  SentenceBuilder& add_longitude(double degrees, int decimals = 4);
+  /// hhmmss.ss, with second in [0, 60)
+  SentenceBuilder& add_time(int hour, int minute, float second,
+                            int decimals = 2);
+  /// hhmmss.ss of the UTC time of day
+  SentenceBuilder& add_time(time_t time, int decimals = 2);
+  /// ddmmyy of the UTC date
+  SentenceBuilder& add_date(time_t time);
+
+  /// Append the checksum. Returns the sentence or nullptr on overflow.
+  const char* finish();
+
+  /// Discard the sentence being written
+  void clear();
+
+  bool ok() const { return ok_; }
+  size_t length() const { return length_; }
+  const char* c_str() const { return buffer_; }
+
+ protected:
+  void put(char c);
+  void put(const char* s, size_t length);
+  /// Write value with at least width digits
+  void put_digits(uint64_t value, int width);
+  /// Write value / 10^decimals with exactly decimals decimals
+  void put_fixed(uint64_t value, int decimals, int int_width);
+  void put_degrees(double degrees, int degree_width, int decimals,
+                   char positive, char negative);
+  void separator() { put(','); }
+
+  char* buffer_;
+  size_t size_;
+  size_t length_ = 0;
+  uint8_t checksum_ = 0;
+  bool finished_ = false;
+  bool ok_ = true;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_BUILDER_H_
@@ -3,9 +3,84 @@
 
 #include "sensesp/system/observablevalue.h"
 #include "sensesp/types/position.h"
+#include "sensesp_nmea0183/data/fixed_string.h"
+#include "sensesp_nmea0183/sentence_parser/field_parsers.h"
 
 namespace sensesp::nmea0183 {
 
+/// Most waypoints collected per RTE route
+constexpr size_t kMaxRouteWaypoints = 64;
+
+/// The waypoint IDs of an RTE route, in order
+struct RouteWaypoints {
+  size_t size = 0;
+  WaypointID ids[kMaxRouteWaypoints];
+};
+
+/**
+ * @brief A route waypoint resolved against a WaypointDatabase.
+ *
+ * The ID is interned in the database. Latitude and longitude are
+ * kInvalidDouble until a position for the waypoint has been received.
+ */
+struct RoutePoint {
+  InternedString id;
+  double latitude = kInvalidDouble;
+  double longitude = kInvalidDouble;
+
+  bool resolved() const {
+    return latitude != kInvalidDouble && longitude != kInvalidDouble;
+  }
+  bool operator==(const RoutePoint& other) const {
+    return id == other.id && latitude == other.latitude &&
+           longitude == other.longitude;
+  }
+  bool operator!=(const RoutePoint& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief An RTE route with the positions of its waypoints.
+ */
+struct Route {
+  WaypointID id;
+  size_t size = 0;
+  RoutePoint points[kMaxRouteWaypoints];
+
+  Route() = default;
+  Route(const Route& other) { *this = other; }
+  /// Copies only the points in use
+  Route& operator=(const Route& other) {
+    id = other.id;
+    size = other.size;
+    for (size_t i = 0; i < size; i++) {
+      points[i] = other.points[i];
+    }
+    return *this;
+  }
+
+  /// True if every waypoint has a position
+  bool resolved() const {
+    for (size_t i = 0; i < size; i++) {
+      if (!points[i].resolved()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool operator==(const Route& other) const {
+    if (id != other.id || size != other.size) {
+      return false;
+    }
+    for (size_t i = 0; i < size; i++) {
+      if (points[i] != other.points[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  bool operator!=(const Route& other) const { return !(*this == other); }
+};
+
 /**
  * @brief Container for waypoint navigation data.
  */
@@ -14,12 +89,15 @@ struct WaypointData {
   ObservableValue<float> bearing_to_destination;      // radians (true)
   ObservableValue<float> range_to_destination;        // meters
   ObservableValue<float> destination_closing_velocity; // m/s
-  ObservableValue<String> destination_waypoint_id;
+  ObservableValue<WaypointID> destination_waypoint_id;
   ObservableValue<Position> waypoint_position;
   ObservableValue<float> heading_to_steer;            // radians (true)
   // Great circle specific
   ObservableValue<float> gc_bearing_true;             // radians
   ObservableValue<float> gc_distance;                 // meters
+  // Set only if a WaypointDatabase is connected. Points to the route kept
+  // by the RouteResolver.
+  ObservableValue<const Route*> route{nullptr};
 };
 
 }  // namespace sensesp::nmea0183
@@ -0,0 +1,129 @@
+#include "waypoint_database.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+/// FNV-1a
+static uint32_t HashID(const char* id) {
+  uint32_t hash = 2166136261u;
+  for (; *id; id++) {
+    hash ^= static_cast<uint8_t>(*id);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+WaypointDatabase::WaypointDatabase() {
+  for (size_t i = 0; i < kTableSize; i++) {
+    table_[i] = kEmpty;
+  }
+}
+
+size_t WaypointDatabase::probe(const char* id) const {
+  size_t slot = HashID(id) % kTableSize;
+  // The table is never more than half full, so an empty slot is found
+  while (table_[slot] != kEmpty &&
+         strcmp(id_pool_ + records_[table_[slot]].id_offset, id) != 0) {
+    slot = (slot + 1) % kTableSize;
+  }
+  return slot;
+}
+
+int WaypointDatabase::find(const char* id) const {
+  size_t slot = probe(id);
+  return table_[slot] == kEmpty ? -1 : table_[slot];
+}
+
+int WaypointDatabase::intern(const char* id) {
+  size_t slot = probe(id);
+  if (table_[slot] != kEmpty) {
+    return table_[slot];
+  }
+
+  size_t length = strlen(id) + 1;
+  if (size_ >= kMaxWaypoints || id_pool_used_ + length > kWaypointIDPoolSize) {
+    rejected_count_++;
+    ESP_LOGW("SensESP/NMEA0183", "Waypoint database full, dropping %s", id);
+    return -1;
+  }
+
+  Record& record = records_[size_];
+  record.id_offset = id_pool_used_;
+  memcpy(id_pool_ + id_pool_used_, id, length);
+  id_pool_used_ += length;
+  table_[slot] = size_;
+  return size_++;
+}
+
+bool WaypointDatabase::set_position(const char* id, double latitude,
+                                    double longitude) {
+  int index = intern(id);
+  if (index < 0) {
+    return false;
+  }
+  Record& record = records_[index];
+  if (record.latitude != latitude || record.longitude != longitude) {
+    record.latitude = latitude;
+    record.longitude = longitude;
+    changed_.set(index);
+  }
+  return true;
+}
+
+RoutePoint WaypointDatabase::get(int index) const {
+  RoutePoint point;
+  point.id = id_pool_ + records_[index].id_offset;
+  point.latitude = records_[index].latitude;
+  point.longitude = records_[index].longitude;
+  return point;
+}
+
+RouteResolver::RouteResolver(WaypointDatabase* database)
+    : ValueProducer<const Route*>(&route_), database_{database} {
+  database_->changed_.attach([this]() {
+    int changed = database_->changed_.get();
+    for (size_t i = 0; i < num_indices_; i++) {
+      if (indices_[i] == changed) {
+        resolve();
+        return;
+      }
+    }
+  });
+}
+
+void RouteResolver::set_route(const char* route_id,
+                              const WaypointID* waypoints,
+                              size_t num_waypoints) {
+  route_id_.assign(route_id);
+  num_indices_ = 0;
+  for (size_t i = 0; i < num_waypoints; i++) {
+    if (num_indices_ >= kMaxRouteWaypoints) {
+      break;
+    }
+    // Unknown waypoints are interned so that a later WPL resolves them
+    int index = database_->intern(waypoints[i].c_str());
+    if (index >= 0) {
+      indices_[num_indices_++] = index;
+    }
+  }
+  resolve();
+}
+
+void RouteResolver::resolve() {
+  bool changed = route_.id != route_id_ || route_.size != num_indices_;
+  route_.id = route_id_;
+  route_.size = num_indices_;
+  for (size_t i = 0; i < num_indices_; i++) {
+    RoutePoint point = database_->get(indices_[i]);
+    if (point != route_.points[i]) {
+      route_.points[i] = point;
+      changed = true;
+    }
+  }
+  if (changed) {
+    this->emit(&route_);
+  }
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,107 @@
+#ifndef SENSESP_NMEA0183_WAYPOINT_DATABASE_H_
+#define SENSESP_NMEA0183_WAYPOINT_DATABASE_H_
+
+#include <vector>
+
+#include "sensesp/system/observablevalue.h"
+#include "sensesp/system/valueproducer.h"
+#include "sensesp_nmea0183/data/waypoint_data.h"
+
+namespace sensesp::nmea0183 {
+
+/// Most waypoints kept in a WaypointDatabase
+constexpr size_t kMaxWaypoints = 256;
+/// Bytes of waypoint ID text kept in a WaypointDatabase, including the
+/// terminating 0s
+constexpr size_t kWaypointIDPoolSize = 4096;
+
+/**
+ * @brief Bounded store of waypoint positions by ID.
+ *
+ * Waypoints are found through an open-addressing hash table with linear
+ * probing, sized at twice kMaxWaypoints. IDs are interned in a fixed text
+ * pool, so the c_str() of a waypoint ID stays valid for the life of the
+ * database and can be held in InternedStrings. Nothing is ever removed:
+ * once kMaxWaypoints waypoints or the ID pool are used up, new IDs are
+ * rejected. The memory use is sizeof(WaypointDatabase) and never grows.
+ */
+class WaypointDatabase {
+ public:
+  WaypointDatabase();
+
+  /// Index of the waypoint id, or -1 if unknown
+  int find(const char* id) const;
+  /// Index of the waypoint id, added without a position if new. -1 if the
+  /// database is full.
+  int intern(const char* id);
+  /**
+   * @brief Set the position of waypoint id, adding it if new.
+   *
+   * Notifies changed_ if the position differs from the stored one. Returns
+   * false if the database is full.
+   */
+  bool set_position(const char* id, double latitude, double longitude);
+
+  /// The waypoint at index, with its interned ID
+  RoutePoint get(int index) const;
+
+  size_t size() const { return size_; }
+  static constexpr size_t capacity() { return kMaxWaypoints; }
+  /// Number of waypoints rejected because the database was full
+  unsigned int get_rejected_count() const { return rejected_count_; }
+
+  /// Index of the last waypoint whose position changed
+  ObservableValue<int> changed_;
+
+ protected:
+  static constexpr size_t kTableSize = 2 * kMaxWaypoints;
+  static constexpr uint16_t kEmpty = 0xFFFF;
+
+  struct Record {
+    double latitude = kInvalidDouble;
+    double longitude = kInvalidDouble;
+    uint16_t id_offset = 0;  // In id_pool_
+  };
+
+  /// Table slot of id, either holding it or the empty slot where it belongs
+  size_t probe(const char* id) const;
+
+  uint16_t table_[kTableSize];  // Record indices
+  Record records_[kMaxWaypoints];
+  char id_pool_[kWaypointIDPoolSize];
+  size_t size_ = 0;
+  size_t id_pool_used_ = 0;
+  unsigned int rejected_count_ = 0;
+};
+
+/**
+ * @brief Resolve RTE routes into waypoint positions.
+ *
+ * set_route() looks up the waypoint IDs of a route in a WaypointDatabase.
+ * The route is emitted when it differs from the last one emitted, and again
+ * whenever one of its waypoints gets a new position. What is emitted is a
+ * pointer to the route kept by the resolver, which stays unchanged until
+ * the next emission.
+ */
+class RouteResolver : public ValueProducer<const Route*> {
+ public:
+  RouteResolver(WaypointDatabase* database);
+
+  /// Resolve the route of the num_waypoints waypoint IDs in waypoints
+  void set_route(const char* route_id, const WaypointID* waypoints,
+                 size_t num_waypoints);
+
+ protected:
+  /// Rebuild the route from the database and emit it if it changed
+  void resolve();
+
+  WaypointDatabase* database_;
+  WaypointID route_id_;
+  int indices_[kMaxRouteWaypoints];
+  size_t num_indices_ = 0;
+  Route route_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_WAYPOINT_DATABASE_H_
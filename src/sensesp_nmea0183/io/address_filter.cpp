@@ -0,0 +1,96 @@
+#include "address_filter.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+static size_t AddressLength(const char* pattern) {
+  const char* comma = strchr(pattern, ',');
+  return comma == nullptr ? strlen(pattern) : comma - pattern;
+}
+
+bool AddressFilter::Pack(const char* s, size_t length, Pattern* pattern) {
+  if (length == 0 || length > kMaxSentenceAddressLength) {
+    return false;
+  }
+  pattern->value = 0;
+  pattern->mask = 0;
+  pattern->length = length;
+  for (size_t i = 0; i < length; i++) {
+    if (s[i] != '.') {
+      pattern->value |= static_cast<uint64_t>(static_cast<uint8_t>(s[i]))
+                        << (8 * i);
+      pattern->mask |= static_cast<uint64_t>(0xFF) << (8 * i);
+    }
+  }
+  return true;
+}
+
+bool AddressFilter::Matches(const std::vector<Pattern>& patterns,
+                            const Pattern& address) {
+  for (const Pattern& pattern : patterns) {
+    if (pattern.length == address.length &&
+        (address.value & pattern.mask) == pattern.value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AddressFilter::add(const char* pattern) {
+  Pattern packed;
+  size_t length = AddressLength(pattern);
+  if (!Pack(pattern, length, &packed)) {
+    // Can't be matched compactly; don't lose the sentences
+    ESP_LOGW("SensESP/NMEA0183", "Address pattern %s too long to filter",
+             pattern);
+    accept_all_ = true;
+    return;
+  }
+  for (const Pattern& existing : added_) {
+    if (existing.value == packed.value && existing.mask == packed.mask &&
+        existing.length == packed.length) {
+      return;
+    }
+  }
+  added_.push_back(packed);
+  char last = pattern[length - 1];
+  if (last == '.') {
+    last_chars_ = 0xFFFFFFFF;
+  } else {
+    last_chars_ |= 1UL << (last % 32);
+  }
+}
+
+void AddressFilter::deny(const char* pattern) {
+  Pattern packed;
+  if (Pack(pattern, AddressLength(pattern), &packed)) {
+    denied_.push_back(packed);
+  }
+}
+
+void AddressFilter::clear() {
+  added_.clear();
+  denied_.clear();
+  last_chars_ = 0;
+  accept_all_ = false;
+}
+
+bool AddressFilter::accepts(const char* address, size_t length) const {
+  Pattern packed;
+  if (!Pack(address, length, &packed)) {
+    return accept_all_;
+  }
+  if (Matches(denied_, packed)) {
+    return false;
+  }
+  if (accept_all_) {
+    return true;
+  }
+  if (!(last_chars_ & (1UL << (address[length - 1] % 32)))) {
+    return false;
+  }
+  return Matches(added_, packed);
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,57 @@
+#ifndef SENSESP_NMEA0183_ADDRESS_FILTER_H_
+#define SENSESP_NMEA0183_ADDRESS_FILTER_H_
+
+#include <Arduino.h>
+
+#include <vector>
+
+namespace sensesp::nmea0183 {
+
+/// Longest sentence address an AddressFilter pattern can match
+constexpr size_t kMaxSentenceAddressLength = 8;
+
+/**
+ * @brief Set of sentence address patterns.
+ *
+ * A pattern is the address field of a sentence, up to the first comma, with
+ * '.' matching any character, as in SentenceParser::sentence_address(). An
+ * address is accepted if it matches an added pattern and no denied one.
+ *
+ * Patterns are packed into a 64-bit value and mask each, so matching an
+ * address is a few integer comparisons. A bitset of the last characters of
+ * the patterns rejects most unwanted addresses with one test.
+ */
+class AddressFilter {
+ public:
+  /// Accept addresses matching pattern. Only the part before a comma is used.
+  void add(const char* pattern);
+  /// Reject addresses matching pattern even if they were added
+  void deny(const char* pattern);
+  /// Accept every address not denied
+  void add_all() { accept_all_ = true; }
+  void clear();
+
+  bool accepts(const char* address, size_t length) const;
+
+ protected:
+  struct Pattern {
+    uint64_t value;
+    uint64_t mask;
+    uint8_t length;
+  };
+
+  /// Pack the first length characters of s. False if too long.
+  static bool Pack(const char* s, size_t length, Pattern* pattern);
+  static bool Matches(const std::vector<Pattern>& patterns,
+                      const Pattern& address);
+
+  std::vector<Pattern> added_;
+  std::vector<Pattern> denied_;
+  // Bit c % 32 is set if an added pattern ends in c
+  uint32_t last_chars_ = 0;
+  bool accept_all_ = false;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_ADDRESS_FILTER_H_
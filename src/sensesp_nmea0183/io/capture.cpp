@@ -0,0 +1,140 @@
+#include "capture.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+CaptureWriter::CaptureWriter(Print* out) : out_{out} {}
+
+void CaptureWriter::write_varint(uint32_t value) {
+  uint8_t buffer[5];
+  size_t length = 0;
+  do {
+    uint8_t byte = value & 0x7F;
+    value >>= 7;
+    buffer[length++] = value ? byte | 0x80 : byte;
+  } while (value);
+  size_ += out_->write(buffer, length);
+}
+
+void CaptureWriter::write(uint8_t source, const uint8_t* data, size_t length,
+                          uint32_t time_us) {
+  if (!started_) {
+    size_ += out_->write(kCaptureHeader, kCaptureHeaderLength);
+    last_time_us_ = time_us;
+    started_ = true;
+  }
+  write_varint(time_us - last_time_us_);
+  last_time_us_ = time_us;
+  size_ += out_->write(&source, 1);
+  write_varint(length);
+  size_ += out_->write(data, length);
+  record_count_++;
+}
+
+CaptureReader::CaptureReader(const uint8_t* capture, size_t length)
+    : capture_{capture}, length_{length} {
+  ok_ = length >= kCaptureHeaderLength &&
+        memcmp(capture, kCaptureHeader, kCaptureHeaderLength) == 0;
+}
+
+bool CaptureReader::read_varint(uint32_t* value) {
+  *value = 0;
+  for (int shift = 0; shift < 35 && position_ < length_; shift += 7) {
+    uint8_t byte = capture_[position_++];
+    *value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CaptureReader::next(CaptureRecord* record) {
+  if (!ok_) {
+    return false;
+  }
+  uint32_t length;
+  if (!read_varint(&record->delta_us) || position_ >= length_) {
+    return false;
+  }
+  record->source = capture_[position_++];
+  if (!read_varint(&length) || length > length_ - position_) {
+    return false;
+  }
+  record->data = capture_ + position_;
+  record->length = length;
+  position_ += length;
+  return true;
+}
+
+CaptureReplayStream::CaptureReplayStream(const uint8_t* capture, size_t length,
+                                         float speed, int source)
+    : reader_{capture, length}, speed_{speed}, source_{source} {}
+
+uint64_t CaptureReplayStream::elapsed_us() {
+  uint32_t now = micros();
+  if (!started_) {
+    last_us_ = now;
+    started_ = true;
+  }
+  elapsed_us_ += now - last_us_;
+  last_us_ = now;
+  return elapsed_us_;
+}
+
+bool CaptureReplayStream::advance() {
+  if (!pending_ && position_ < record_.length) {
+    return true;
+  }
+  uint64_t elapsed = elapsed_us();
+  while (true) {
+    if (!pending_) {
+      if (!reader_.next(&record_)) {
+        record_.length = 0;
+        end_ = true;
+        return false;
+      }
+      // Skipped records still take their time
+      record_time_us_ += record_.delta_us;
+      position_ = 0;
+      if ((source_ >= 0 && record_.source != source_) ||
+          record_.length == 0) {
+        continue;
+      }
+      pending_ = true;
+    }
+    if (speed_ > 0 && elapsed * speed_ < record_time_us_) {
+      return false;
+    }
+    pending_ = false;
+    return true;
+  }
+}
+
+int CaptureReplayStream::available() {
+  return advance() ? record_.length - position_ : 0;
+}
+
+int CaptureReplayStream::read() {
+  return advance() ? record_.data[position_++] : -1;
+}
+
+int CaptureReplayStream::peek() {
+  return advance() ? record_.data[position_] : -1;
+}
+
+bool CaptureReplayStream::finished() { return !advance() && end_; }
+
+void CaptureReplayStream::rewind() {
+  reader_.rewind();
+  record_ = CaptureRecord();
+  position_ = 0;
+  record_time_us_ = 0;
+  pending_ = false;
+  started_ = false;
+  end_ = false;
+  elapsed_us_ = 0;
+}
+
+}  // namespace sensesp::nmea0183
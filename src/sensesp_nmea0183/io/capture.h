@@ -0,0 +1,136 @@
+#ifndef SENSESP_NMEA0183_CAPTURE_H_
+#define SENSESP_NMEA0183_CAPTURE_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/// Start of every capture: "NCAP" and the format version
+constexpr uint8_t kCaptureHeader[] = {'N', 'C', 'A', 'P', 1};
+constexpr size_t kCaptureHeaderLength = sizeof(kCaptureHeader);
+
+/**
+ * @brief One record of a capture: bytes received in one read.
+ *
+ * Encoded as the varint time since the previous record in microseconds,
+ * the source ID byte, the varint length and the bytes themselves. Varints
+ * are unsigned LEB128: 7 bits per byte, least significant first, with the
+ * high bit set on all but the last byte.
+ */
+struct CaptureRecord {
+  uint32_t delta_us = 0;
+  uint8_t source = 0;
+  const uint8_t* data = nullptr;
+  size_t length = 0;
+};
+
+/**
+ * @brief Write received bytes in the capture format.
+ *
+ * The output can be any Print, such as a File or a StringPrint.
+ */
+class CaptureWriter {
+ public:
+  CaptureWriter(Print* out);
+
+  /// Record length bytes received from source at time_us, as micros()
+  void write(uint8_t source, const uint8_t* data, size_t length,
+             uint32_t time_us);
+  void write(uint8_t source, const uint8_t* data, size_t length) {
+    write(source, data, length, micros());
+  }
+
+  /// Number of records written
+  unsigned int get_record_count() const { return record_count_; }
+  /// Number of bytes written, including the header and record headers
+  size_t get_size() const { return size_; }
+
+ protected:
+  void write_varint(uint32_t value);
+
+  Print* out_;
+  bool started_ = false;
+  uint32_t last_time_us_ = 0;
+  unsigned int record_count_ = 0;
+  size_t size_ = 0;
+};
+
+/**
+ * @brief Read the records of a capture held in memory.
+ *
+ * The records point into the capture, which has to outlive them.
+ */
+class CaptureReader {
+ public:
+  CaptureReader(const uint8_t* capture, size_t length);
+
+  /// False if the capture doesn't start with kCaptureHeader
+  bool ok() const { return ok_; }
+  /// Read the next record. False at the end or on a truncated record.
+  bool next(CaptureRecord* record);
+  /// Start again from the first record
+  void rewind() { position_ = kCaptureHeaderLength; }
+
+ protected:
+  bool read_varint(uint32_t* value);
+
+  const uint8_t* capture_;
+  size_t length_;
+  size_t position_ = kCaptureHeaderLength;
+  bool ok_;
+};
+
+/**
+ * @brief A Stream that replays a capture, e.g. in place of HardwareSerial.
+ *
+ * The bytes of each record become available when the record is due: at
+ * its recorded time divided by speed, counted from the first read. A speed
+ * of 0 replays as fast as the bytes are read. Writes are discarded.
+ *
+ *   CaptureReplayStream replay(capture, capture_length, 10);
+ *   auto* nmea_io = new NMEA0183IO(&replay);
+ */
+class CaptureReplayStream : public Stream {
+ public:
+  /// Replay the records of source, or of all sources if source is -1
+  CaptureReplayStream(const uint8_t* capture, size_t length, float speed = 1,
+                      int source = -1);
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t) override { return 1; }
+
+  /// Replay speed, set before the replay starts
+  void set_speed(float speed) { speed_ = speed; }
+  /// True when every record has been read
+  bool finished();
+  /// Start the replay again
+  void rewind();
+
+ protected:
+  /// Make the next due record current if the current one has been read.
+  /// False if no bytes are available.
+  bool advance();
+  /// Time since the first read
+  uint64_t elapsed_us();
+
+  CaptureReader reader_;
+  float speed_;
+  int source_;
+  CaptureRecord record_;
+  size_t position_ = 0;
+  // Recorded time of record_ since the start of the capture
+  uint64_t record_time_us_ = 0;
+  // Record read ahead by advance() but not yet due
+  bool pending_ = false;
+  bool started_ = false;
+  bool end_ = false;
+  // Kept in 64 bits, as micros() wraps after 71 minutes
+  uint64_t elapsed_us_ = 0;
+  uint32_t last_us_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_CAPTURE_H_
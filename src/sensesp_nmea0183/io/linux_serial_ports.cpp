@@ -0,0 +1,204 @@
+#ifdef __linux__
+
+#include "linux_serial_ports.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "sensesp_nmea0183/io/socket_util.h"
+
+namespace sensesp::nmea0183 {
+
+// Tag of the wake-up eventfd in the epoll data; ports are tagged with their
+// index
+static constexpr uint64_t kWakeTag = ~0ULL;
+
+static speed_t BaudToSpeed(int baud) {
+  switch (baud) {
+    case 4800:
+      return B4800;
+    case 9600:
+      return B9600;
+    case 19200:
+      return B19200;
+    case 38400:
+      return B38400;
+    case 57600:
+      return B57600;
+    case 115200:
+      return B115200;
+    default:
+      return B0;
+  }
+}
+
+NMEA0183SerialPorts::NMEA0183SerialPorts(NMEA0183Parser* parser)
+    : parser_{parser} {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.u64 = kWakeTag;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+}
+
+NMEA0183SerialPorts::~NMEA0183SerialPorts() {
+  for (auto& port : ports_) {
+    close_port(*port);
+  }
+  close(wake_fd_);
+  close(epoll_fd_);
+}
+
+int NMEA0183SerialPorts::open_port(const char* path, int baud) {
+  int fd = open(path, O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    ESP_LOGW("SensESP/NMEA0183", "Can't open %s", path);
+    return -1;
+  }
+  struct termios settings;
+  if (tcgetattr(fd, &settings) == 0) {
+    cfmakeraw(&settings);
+    speed_t speed = BaudToSpeed(baud);
+    if (speed == B0) {
+      ESP_LOGW("SensESP/NMEA0183", "Unsupported baud rate %d", baud);
+      close(fd);
+      return -1;
+    }
+    cfsetispeed(&settings, speed);
+    cfsetospeed(&settings, speed);
+    settings.c_cflag |= CLOCAL | CREAD;
+    tcsetattr(fd, TCSANOW, &settings);
+  }
+  int index = add_fd(fd, true);
+  if (index < 0) {
+    close(fd);
+  }
+  return index;
+}
+
+int NMEA0183SerialPorts::add_fd(int fd, bool owned) {
+  if (!SetNonBlocking(fd)) {
+    return -1;
+  }
+  int index = ports_.size();
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.u64 = index;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+    return -1;
+  }
+  ports_.emplace_back(new Port(
+      fd, owned, [this](const char* sentence) { parser_->parse(sentence); },
+      [this](const char* address, size_t length) {
+        return parser_->accepts_address(address, length);
+      }));
+  ports_.back()->stats.open = true;
+  return index;
+}
+
+const SerialPortStats& NMEA0183SerialPorts::get_stats(int port) const {
+  return ports_[port]->stats;
+}
+
+size_t NMEA0183SerialPorts::get_open_port_count() const {
+  size_t count = 0;
+  for (const auto& port : ports_) {
+    if (port->stats.open) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void NMEA0183SerialPorts::close_port(Port& port) {
+  if (!port.stats.open) {
+    return;
+  }
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, port.fd, nullptr);
+  if (port.owned) {
+    close(port.fd);
+  }
+  port.stats.open = false;
+}
+
+bool NMEA0183SerialPorts::read_port(Port& port) {
+  uint8_t buffer[256];
+  ssize_t length;
+  while ((length = read(port.fd, buffer, sizeof(buffer))) > 0) {
+    port.stats.bytes += length;
+    port.stats.reads++;
+    port.framer.feed(buffer, length);
+  }
+  port.stats.sentences = port.framer.get_accepted_count();
+  port.stats.rejected = port.framer.get_rejected_count();
+  port.stats.overflows = port.framer.get_overflow_count();
+  // A pty whose other end has been closed reads EIO
+  return length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+bool NMEA0183SerialPorts::clear_wake() {
+  uint64_t value;
+  ssize_t length;
+  do {
+    length = read(wake_fd_, &value, sizeof(value));
+  } while (length < 0 && errno == EINTR);
+  // EAGAIN: nothing was written since the last read
+  return length == sizeof(value);
+}
+
+int NMEA0183SerialPorts::run_once(int timeout_ms) {
+  struct epoll_event events[8];
+  int count = epoll_wait(epoll_fd_, events, 8, timeout_ms);
+  if (count < 0) {
+    return errno == EINTR ? 0 : -1;
+  }
+  int ports_read = 0;
+  for (int i = 0; i < count; i++) {
+    if (events[i].data.u64 == kWakeTag) {
+      if (clear_wake()) {
+        running_ = false;
+      }
+      continue;
+    }
+    Port& port = *ports_[events[i].data.u64];
+    if (!read_port(port)) {
+      ESP_LOGW("SensESP/NMEA0183", "Serial port %d hung up",
+               static_cast<int>(events[i].data.u64));
+      close_port(port);
+    }
+    ports_read++;
+  }
+  return ports_read;
+}
+
+void NMEA0183SerialPorts::run() {
+  // Forget a stop() that came before this run
+  clear_wake();
+  running_ = true;
+  while (running_ && get_open_port_count() > 0) {
+    if (run_once(-1) < 0) {
+      break;
+    }
+  }
+}
+
+void NMEA0183SerialPorts::stop() {
+  uint64_t value = 1;
+  ssize_t length;
+  do {
+    length = write(wake_fd_, &value, sizeof(value));
+  } while (length < 0 && errno == EINTR);
+  // EAGAIN means the counter is full, so a wake-up is pending anyway
+  if (length < 0 && errno != EAGAIN) {
+    ESP_LOGW("SensESP/NMEA0183", "Can't wake up the serial port loop");
+  }
+}
+
+}  // namespace sensesp::nmea0183
+
+#endif  // __linux__
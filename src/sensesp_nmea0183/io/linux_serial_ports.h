@@ -0,0 +1,104 @@
+#ifndef SENSESP_NMEA0183_LINUX_SERIAL_PORTS_H_
+#define SENSESP_NMEA0183_LINUX_SERIAL_PORTS_H_
+
+#ifdef __linux__
+
+#include <memory>
+#include <vector>
+
+#include "sensesp_nmea0183/io/sentence_framer.h"
+#include "sensesp_nmea0183/nmea0183.h"
+
+namespace sensesp::nmea0183 {
+
+/// Throughput counters of one port of NMEA0183SerialPorts
+struct SerialPortStats {
+  unsigned long bytes = 0;          // Bytes read
+  unsigned long reads = 0;          // read() calls that returned data
+  unsigned long sentences = 0;      // Sentences passed to the parser
+  unsigned long rejected = 0;       // Sentences skipped by the address filter
+  unsigned long overflows = 0;      // Sentences skipped for being too long
+  bool open = false;                // False after the port hung up
+};
+
+/**
+ * @brief Read NMEA 0183 from several Linux serial ports with one epoll loop.
+ *
+ * For running the parsers on a Linux gateway instead of an ESP32. Every
+ * port, a tty device or a pty, has its own SentenceFramer, and all of them
+ * feed the same NMEA0183Parser, so the sentence parsers and the Connect*
+ * wiring work as with NMEA0183IO.
+ *
+ * The loop blocks in epoll_wait() until a port has data, so an idle
+ * gateway uses no CPU. Timers of the SensESP event loop are not run by
+ * run(); to have them, alternate run_once() with event_loop()->tick().
+ *
+ *   NMEA0183Parser parser;
+ *   NMEA0183SerialPorts ports(&parser);
+ *   ports.open_port("/dev/ttyUSB0", 4800);
+ *   ports.open_port("/dev/ttyUSB1", 38400);
+ *   ConnectGNSS(&parser, &gnss_data);
+ *   ports.run();
+ */
+class NMEA0183SerialPorts {
+ public:
+  NMEA0183SerialPorts(NMEA0183Parser* parser);
+  ~NMEA0183SerialPorts();
+
+  /// Open a tty or pty device in raw mode at baud. Returns the port index,
+  /// or -1 on failure.
+  int open_port(const char* path, int baud = 4800);
+  /// Read from an open file descriptor, which is closed with the ports if
+  /// owned. Returns the port index, or -1 on failure.
+  int add_fd(int fd, bool owned = false);
+
+  /**
+   * @brief Wait for data on the ports and read it.
+   *
+   * @param timeout_ms Longest time to wait. -1 waits until data arrives or
+   * stop() is called.
+   * @return The number of ports read, or -1 on error.
+   */
+  int run_once(int timeout_ms);
+  /// Run until stop() is called or all ports have hung up
+  void run();
+  /// Make run() return. Can be called from another thread or a signal
+  /// handler. A stop() while run() isn't running is forgotten when run()
+  /// starts.
+  void stop();
+
+  size_t get_port_count() const { return ports_.size(); }
+  const SerialPortStats& get_stats(int port) const;
+
+ protected:
+  struct Port {
+    Port(int fd, bool owned, SentenceFramer::SentenceFunction on_sentence,
+         SentenceFramer::AddressFilterFunction accepts_address)
+        : fd{fd}, owned{owned}, framer{on_sentence, accepts_address} {}
+
+    int fd;
+    bool owned;
+    SentenceFramer framer;
+    SerialPortStats stats;
+  };
+
+  /// Read what is available on a port. False if it hung up.
+  bool read_port(Port& port);
+  void close_port(Port& port);
+  size_t get_open_port_count() const;
+  /// Read the wake-up eventfd. True if stop() had written to it.
+  bool clear_wake();
+
+  NMEA0183Parser* parser_;
+  int epoll_fd_;
+  // Written by stop() to wake up epoll_wait()
+  int wake_fd_;
+  bool running_ = false;
+  std::vector<std::unique_ptr<Port>> ports_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // __linux__
+
+#endif  // SENSESP_NMEA0183_LINUX_SERIAL_PORTS_H_
@@ -0,0 +1,139 @@
+#include "output_queue.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+OutputQueue::OutputQueue() {
+  for (size_t i = 0; i < kNumOutputPriorities; i++) {
+    head_[i] = kNoSlot;
+    tail_[i] = kNoSlot;
+  }
+  for (size_t i = 0; i < kOutputQueueSlots; i++) {
+    release(i);
+  }
+}
+
+uint8_t OutputQueue::allocate() {
+  uint8_t slot = free_;
+  if (slot != kNoSlot) {
+    free_ = slots_[slot].next;
+  }
+  return slot;
+}
+
+void OutputQueue::release(uint8_t slot) {
+  slots_[slot].next = free_;
+  free_ = slot;
+}
+
+bool OutputQueue::evict(size_t priority) {
+  uint8_t slot = head_[priority];
+  if (slot == kNoSlot) {
+    return false;
+  }
+  head_[priority] = slots_[slot].next;
+  if (head_[priority] == kNoSlot) {
+    tail_[priority] = kNoSlot;
+  }
+  release(slot);
+  depth_--;
+  dropped_count_[priority]++;
+  return true;
+}
+
+bool OutputQueue::push(const char* sentence, OutputPriority priority) {
+  size_t p = static_cast<size_t>(priority);
+  size_t length = strlen(sentence);
+  if (length > kMaxFramedSentenceLength) {
+    dropped_count_[p]++;
+    return false;
+  }
+
+  if (free_ == kNoSlot) {
+    // Make room by dropping the oldest sentence of the lowest priority
+    // below this one
+    bool evicted = false;
+    for (size_t lower = kNumOutputPriorities - 1; lower > p && !evicted;
+         lower--) {
+      evicted = evict(lower);
+    }
+    if (!evicted) {
+      dropped_count_[p]++;
+      return false;
+    }
+  }
+
+  uint8_t slot = allocate();
+  memcpy(slots_[slot].data, sentence, length);
+  slots_[slot].data[length] = '\r';
+  slots_[slot].data[length + 1] = '\n';
+  slots_[slot].length = length + 2;
+  slots_[slot].next = kNoSlot;
+  if (tail_[p] == kNoSlot) {
+    head_[p] = slot;
+  } else {
+    slots_[tail_[p]].next = slot;
+  }
+  tail_[p] = slot;
+
+  depth_++;
+  if (depth_ > max_depth_) {
+    max_depth_ = depth_;
+  }
+  return true;
+}
+
+bool OutputQueue::select() {
+  for (size_t p = 0; p < kNumOutputPriorities; p++) {
+    uint8_t slot = head_[p];
+    if (slot != kNoSlot) {
+      head_[p] = slots_[slot].next;
+      if (head_[p] == kNoSlot) {
+        tail_[p] = kNoSlot;
+      }
+      current_ = slot;
+      current_written_ = 0;
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t OutputQueue::drain(Print* stream) {
+  size_t total = 0;
+  while (depth_ > 0) {
+    // Only commit to the next sentence once it can be started
+    int space = stream->availableForWrite();
+    if (space <= 0 || (current_ == kNoSlot && !select())) {
+      break;
+    }
+    Slot& slot = slots_[current_];
+    size_t remaining = slot.length - current_written_;
+    size_t length = stream->write(
+        reinterpret_cast<const uint8_t*>(slot.data + current_written_),
+        remaining < static_cast<size_t>(space) ? remaining : space);
+    if (length == 0) {
+      break;
+    }
+    current_written_ += length;
+    total += length;
+    if (current_written_ == slot.length) {
+      release(current_);
+      current_ = kNoSlot;
+      depth_--;
+      written_count_++;
+    }
+  }
+  return total;
+}
+
+unsigned int OutputQueue::get_dropped_count() const {
+  unsigned int total = 0;
+  for (size_t i = 0; i < kNumOutputPriorities; i++) {
+    total += dropped_count_[i];
+  }
+  return total;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,93 @@
+#ifndef SENSESP_NMEA0183_OUTPUT_QUEUE_H_
+#define SENSESP_NMEA0183_OUTPUT_QUEUE_H_
+
+#include <Arduino.h>
+
+#include "sensesp_nmea0183/io/sentence_framer.h"
+
+namespace sensesp::nmea0183 {
+
+/// Priority of an output sentence. Higher priorities are written first.
+enum class OutputPriority : uint8_t {
+  high = 0,    // E.g. autopilot sentences
+  normal = 1,
+  low = 2,     // Informational sentences
+};
+
+constexpr size_t kNumOutputPriorities = 3;
+
+/// Number of sentences an OutputQueue holds
+constexpr size_t kOutputQueueSlots = 16;
+
+/**
+ * @brief Fixed-size queue of outgoing sentences with priorities.
+ *
+ * Sentences are copied into fixed slots, with a CR LF line ending. drain()
+ * writes as many bytes as the stream can take without blocking, highest
+ * priority first and in order within a priority. A sentence that has been
+ * partly written is always finished before the next one starts.
+ *
+ * When the queue is full, a new sentence replaces the oldest queued sentence
+ * of the lowest priority below its own. If there is none, the new sentence
+ * is dropped. Either way, the drop is counted for the priority of the
+ * sentence that was lost.
+ */
+class OutputQueue {
+ public:
+  OutputQueue();
+
+  /// Queue a sentence without line ending. False if it was dropped.
+  bool push(const char* sentence,
+            OutputPriority priority = OutputPriority::normal);
+
+  /// Write queued sentences while stream has space. Returns the number of
+  /// bytes written.
+  size_t drain(Print* stream);
+
+  bool empty() const { return depth_ == 0; }
+  /// Number of sentences queued
+  size_t get_depth() const { return depth_; }
+  /// Highest number of sentences queued at once
+  size_t get_max_depth() const { return max_depth_; }
+  /// Number of sentences written completely
+  unsigned int get_written_count() const { return written_count_; }
+  /// Number of sentences of a priority that were dropped
+  unsigned int get_dropped_count(OutputPriority priority) const {
+    return dropped_count_[static_cast<size_t>(priority)];
+  }
+  /// Number of sentences dropped in total
+  unsigned int get_dropped_count() const;
+
+ protected:
+  static constexpr uint8_t kNoSlot = 0xFF;
+
+  struct Slot {
+    char data[kMaxFramedSentenceLength + 2];
+    uint8_t length;
+    uint8_t next;
+  };
+
+  uint8_t allocate();
+  void release(uint8_t slot);
+  /// Remove the oldest sentence of a priority. False if there is none.
+  bool evict(size_t priority);
+  /// Select the slot to write next into current_
+  bool select();
+
+  Slot slots_[kOutputQueueSlots];
+  // Singly linked FIFO of slots per priority
+  uint8_t head_[kNumOutputPriorities];
+  uint8_t tail_[kNumOutputPriorities];
+  uint8_t free_ = kNoSlot;
+  // Slot being written, already unlinked from its FIFO
+  uint8_t current_ = kNoSlot;
+  uint8_t current_written_ = 0;
+  size_t depth_ = 0;
+  size_t max_depth_ = 0;
+  unsigned int written_count_ = 0;
+  unsigned int dropped_count_[kNumOutputPriorities] = {};
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_OUTPUT_QUEUE_H_
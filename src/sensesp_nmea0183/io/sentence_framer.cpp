@@ -0,0 +1,108 @@
+#include "sentence_framer.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+void SentenceFramer::start(char c) {
+  buffer_[0] = c;
+  length_ = 1;
+  state_ = State::address;
+}
+
+bool SentenceFramer::store(char c) {
+  if (length_ >= kMaxFramedSentenceLength) {
+    overflow_count_++;
+    state_ = State::skip;
+    return false;
+  }
+  buffer_[length_++] = c;
+  return true;
+}
+
+void SentenceFramer::feed(char c) {
+  if (c == '$' || c == '!') {
+    start(c);
+    return;
+  }
+
+  switch (state_) {
+    case State::idle:
+    case State::skip:
+      if (c == '\r' || c == '\n') {
+        state_ = State::idle;
+      }
+      return;
+    case State::address:
+      if (c == '\r' || c == '\n') {
+        // A line with an address only
+        state_ = State::idle;
+        return;
+      }
+      if (c == ',' || c == '*') {
+        if (accepts_address_ && !accepts_address_(buffer_ + 1, length_ - 1)) {
+          rejected_count_++;
+          state_ = State::skip;
+          return;
+        }
+        state_ = State::body;
+      }
+      store(c);
+      return;
+    case State::body:
+      if (c == '\r' || c == '\n') {
+        buffer_[length_] = 0;
+        state_ = State::idle;
+        accepted_count_++;
+        on_sentence_(buffer_);
+        return;
+      }
+      store(c);
+      return;
+  }
+}
+
+void SentenceFramer::frame_line(const char* line, size_t length) {
+  // As in feed(), the last start character starts the sentence
+  const char* sentence = nullptr;
+  for (size_t i = length; i > 0; i--) {
+    if (line[i - 1] == '$' || line[i - 1] == '!') {
+      sentence = line + i - 1;
+      break;
+    }
+  }
+  if (sentence == nullptr) {
+    return;
+  }
+  length -= sentence - line;
+  if (length > kMaxFramedSentenceLength) {
+    overflow_count_++;
+    return;
+  }
+  size_t address_length = strcspn(sentence + 1, ",*");
+  if (sentence[1 + address_length] == 0) {
+    // A line with an address only
+    return;
+  }
+  if (accepts_address_ && !accepts_address_(sentence + 1, address_length)) {
+    rejected_count_++;
+    return;
+  }
+  accepted_count_++;
+  on_sentence_(sentence);
+}
+
+void SentenceFramer::feed_packet(char* packet, size_t length) {
+  state_ = State::idle;
+  packet[length] = 0;
+  char* end = packet + length;
+  char* line = packet;
+  while (line < end) {
+    char* line_end = line + strcspn(line, "\r\n");
+    *line_end = 0;
+    frame_line(line, line_end - line);
+    line = line_end + 1;
+  }
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,90 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_FRAMER_H_
+#define SENSESP_NMEA0183_SENTENCE_FRAMER_H_
+
+#include <Arduino.h>
+
+#include <functional>
+
+namespace sensesp::nmea0183 {
+
+/// Longest sentence a SentenceFramer passes on, with its start character
+/// and without the line ending
+constexpr size_t kMaxFramedSentenceLength = 163;
+
+/**
+ * @brief Split a byte stream into NMEA 0183 sentences.
+ *
+ * Bytes are consumed one at a time into a fixed buffer. A sentence starts at
+ * '$' or '!' and ends at CR or LF. As soon as the address field is complete,
+ * it is passed to the address filter; the rest of a rejected sentence is
+ * skipped without being stored. Accepted sentences are passed to the
+ * sentence callback as a 0-terminated string that is valid during the call.
+ *
+ * A start character inside a sentence starts a new sentence, so the framer
+ * resynchronizes after a garbled line.
+ */
+class SentenceFramer {
+ public:
+  using AddressFilterFunction =
+      std::function<bool(const char* address, size_t length)>;
+  using SentenceFunction = std::function<void(const char* sentence)>;
+
+  SentenceFramer(SentenceFunction on_sentence,
+                 AddressFilterFunction accepts_address = nullptr)
+      : on_sentence_{on_sentence}, accepts_address_{accepts_address} {}
+
+  void set_address_filter(AddressFilterFunction accepts_address) {
+    accepts_address_ = accepts_address;
+  }
+
+  void feed(char c);
+  void feed(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      feed(static_cast<char>(data[i]));
+    }
+  }
+
+  /**
+   * @brief Frame the sentences of a packet, such as a UDP datagram, in place.
+   *
+   * Each line of the packet is filtered and passed on like a sentence read
+   * from a stream, but without copying it: line endings are overwritten
+   * with 0s. The last line ends at the end of the packet, so the packet
+   * needs room for one more byte after length. A packet also ends any
+   * sentence partly fed with feed().
+   */
+  void feed_packet(char* packet, size_t length);
+
+  /// Number of sentences passed on
+  unsigned int get_accepted_count() const { return accepted_count_; }
+  /// Number of sentences skipped because of their address
+  unsigned int get_rejected_count() const { return rejected_count_; }
+  /// Number of sentences skipped because they were too long
+  unsigned int get_overflow_count() const { return overflow_count_; }
+
+ protected:
+  enum class State : uint8_t {
+    idle,     // Waiting for a start character
+    address,  // Storing the address field
+    body,     // Storing the rest of an accepted sentence
+    skip,     // Skipping to the end of the line
+  };
+
+  void start(char c);
+  bool store(char c);
+  /// Pass on the sentence in a 0-terminated line of a packet
+  void frame_line(const char* line, size_t length);
+
+  SentenceFunction on_sentence_;
+  AddressFilterFunction accepts_address_;
+  State state_ = State::idle;
+  char buffer_[kMaxFramedSentenceLength + 1];
+  size_t length_ = 0;
+  unsigned int accepted_count_ = 0;
+  unsigned int rejected_count_ = 0;
+  unsigned int overflow_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_FRAMER_H_
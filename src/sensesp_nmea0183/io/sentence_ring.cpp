@@ -0,0 +1,55 @@
+#include "sentence_ring.h"
+
+#include <string.h>
+
+namespace sensesp::nmea0183 {
+
+void SentenceRing::put(const char* data, size_t length) {
+  size_t offset = head_ & kMask;
+  size_t first = kSentenceRingSize - offset;
+  if (first > length) {
+    first = length;
+  }
+  memcpy(buffer_ + offset, data, first);
+  memcpy(buffer_, data + first, length - first);
+  head_ += length;
+}
+
+void SentenceRing::drop_oldest() {
+  // Every stored sentence ends in LF
+  while (tail_ != head_) {
+    uint8_t c = buffer_[tail_ & kMask];
+    tail_++;
+    if (c == '\n') {
+      break;
+    }
+  }
+  overwritten_count_++;
+}
+
+bool SentenceRing::push(const char* sentence) {
+  size_t length = strlen(sentence);
+  if (length + 2 > kSentenceRingSize) {
+    return false;
+  }
+  while (head_ + length + 2 - tail_ > kSentenceRingSize) {
+    drop_oldest();
+  }
+  put(sentence, length);
+  put("\r\n", 2);
+  sentence_count_++;
+  return true;
+}
+
+size_t SentenceRing::peek(uint32_t cursor, const uint8_t** data) const {
+  if (lapped(cursor)) {
+    return 0;
+  }
+  size_t offset = cursor & kMask;
+  size_t available = head_ - cursor;
+  size_t contiguous = kSentenceRingSize - offset;
+  *data = buffer_ + offset;
+  return available < contiguous ? available : contiguous;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,67 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_RING_H_
+#define SENSESP_NMEA0183_SENTENCE_RING_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/// Bytes a SentenceRing holds. Must be a power of two.
+constexpr size_t kSentenceRingSize = 4096;
+
+/**
+ * @brief Ring of sentences shared by any number of readers.
+ *
+ * Each sentence is stored once, with a CR LF line ending. Positions are
+ * byte counts since the ring was created, wrapping at 2^32, and a reader is
+ * just such a position, its cursor. peek() returns the bytes at a cursor in
+ * place, so they can be passed to send() without copying.
+ *
+ * The writer never waits for readers: when the ring is full, the oldest
+ * whole sentences are overwritten. A reader whose cursor points to
+ * overwritten data is lapped() and has to move to tail() or give up.
+ */
+class SentenceRing {
+ public:
+  /// Append a sentence without line ending. False if it can't fit at all.
+  bool push(const char* sentence);
+
+  /// Position after the newest sentence
+  uint32_t head() const { return head_; }
+  /// Position of the oldest sentence still stored
+  uint32_t tail() const { return tail_; }
+
+  /// True if the data at cursor has been overwritten
+  bool lapped(uint32_t cursor) const {
+    return static_cast<int32_t>(cursor - tail_) < 0;
+  }
+  /// Number of bytes between cursor and head
+  size_t backlog(uint32_t cursor) const { return head_ - cursor; }
+
+  /// Point data to the bytes at cursor and return how many of them are
+  /// contiguous in memory. 0 if there are none or cursor is lapped.
+  size_t peek(uint32_t cursor, const uint8_t** data) const;
+
+  /// Number of sentences pushed
+  unsigned int get_sentence_count() const { return sentence_count_; }
+  /// Number of sentences overwritten to make room
+  unsigned int get_overwritten_count() const { return overwritten_count_; }
+
+ protected:
+  static constexpr uint32_t kMask = kSentenceRingSize - 1;
+  static_assert((kSentenceRingSize & kMask) == 0,
+                "kSentenceRingSize must be a power of two");
+
+  void put(const char* data, size_t length);
+  /// Move tail_ past the oldest sentence
+  void drop_oldest();
+
+  uint8_t buffer_[kSentenceRingSize];
+  uint32_t head_ = 0;
+  uint32_t tail_ = 0;
+  unsigned int sentence_count_ = 0;
+  unsigned int overwritten_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_RING_H_
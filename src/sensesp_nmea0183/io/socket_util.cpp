@@ -0,0 +1,43 @@
+#include "socket_util.h"
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace sensesp::nmea0183 {
+
+bool SetNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int OpenBoundSocket(int type, uint16_t* port, int backlog) {
+  int fd = socket(AF_INET, type, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  int reuse = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  struct sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(*port);
+  socklen_t address_length = sizeof(address);
+  if (bind(fd, reinterpret_cast<struct sockaddr*>(&address),
+           address_length) != 0 ||
+      (type == SOCK_STREAM && listen(fd, backlog) != 0) ||
+      !SetNonBlocking(fd)) {
+    close(fd);
+    return -1;
+  }
+  // Find the port picked for port 0
+  if (getsockname(fd, reinterpret_cast<struct sockaddr*>(&address),
+                  &address_length) == 0) {
+    *port = ntohs(address.sin_port);
+  }
+  return fd;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,27 @@
+#ifndef SENSESP_NMEA0183_SOCKET_UTIL_H_
+#define SENSESP_NMEA0183_SOCKET_UTIL_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/// Set O_NONBLOCK on a file descriptor. False on failure.
+bool SetNonBlocking(int fd);
+
+/**
+ * @brief Open a non-blocking socket bound to a port on all interfaces.
+ *
+ * Stream sockets are also made to listen. Shared by NMEA0183TCPServer and
+ * NMEA0183UDPInput.
+ *
+ * @param type SOCK_STREAM or SOCK_DGRAM
+ * @param port The port to bind to. Port 0 picks a free port, which is
+ * written back to port.
+ * @param backlog Connections queued by listen()
+ * @return The socket, or -1 on failure.
+ */
+int OpenBoundSocket(int type, uint16_t* port, int backlog = 0);
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SOCKET_UTIL_H_
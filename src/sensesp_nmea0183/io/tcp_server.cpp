@@ -0,0 +1,166 @@
+#include "tcp_server.h"
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "sensesp_nmea0183/io/socket_util.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace sensesp::nmea0183 {
+
+NMEA0183TCPServer::~NMEA0183TCPServer() { stop(); }
+
+bool NMEA0183TCPServer::start(bool use_event_loop) {
+  listen_fd_ = OpenBoundSocket(SOCK_STREAM, &port_, kMaxTCPClients);
+  if (listen_fd_ < 0) {
+    ESP_LOGW("SensESP/NMEA0183", "Can't listen to TCP port %u", port_);
+    return false;
+  }
+
+  if (use_event_loop && poll_event_ == nullptr) {
+    poll_event_ = event_loop()->onTick([this]() { poll(); });
+  }
+  return true;
+}
+
+void NMEA0183TCPServer::stop() {
+  if (poll_event_ != nullptr) {
+    event_loop()->remove(poll_event_);
+    poll_event_ = nullptr;
+  }
+  for (Client& client : clients_) {
+    close_client(client);
+  }
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+}
+
+void NMEA0183TCPServer::forward_from(NMEA0183IO* io) {
+  io->on_sentence([this](const char* sentence) { write(sentence); });
+}
+
+size_t NMEA0183TCPServer::get_client_count() const {
+  size_t count = 0;
+  for (const Client& client : clients_) {
+    if (client.fd >= 0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void NMEA0183TCPServer::close_client(Client& client) {
+  if (client.fd >= 0) {
+    close(client.fd);
+    client.fd = -1;
+  }
+}
+
+void NMEA0183TCPServer::accept_clients() {
+  int fd;
+  while ((fd = accept(listen_fd_, nullptr, nullptr)) >= 0) {
+    Client* free_client = nullptr;
+    for (Client& client : clients_) {
+      if (client.fd < 0) {
+        free_client = &client;
+        break;
+      }
+    }
+    if (free_client == nullptr || !SetNonBlocking(fd)) {
+      ESP_LOGW("SensESP/NMEA0183", "Refusing NMEA 0183 TCP client");
+      rejected_client_count_++;
+      close(fd);
+      continue;
+    }
+    *free_client = Client();
+    free_client->fd = fd;
+    free_client->cursor = ring_.head();
+  }
+}
+
+bool NMEA0183TCPServer::serve(Client& client) {
+  // Discard anything the client sends, and notice when it has gone away
+  uint8_t discard[64];
+  ssize_t received = recv(client.fd, discard, sizeof(discard), MSG_DONTWAIT);
+  if (received == 0 ||
+      (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    return false;
+  }
+
+  if (ring_.lapped(client.cursor)) {
+    if (policy_ == SlowClientPolicy::disconnect) {
+      dropped_client_count_++;
+      return false;
+    }
+    skip_count_++;
+    client.cursor = ring_.tail();
+    // The rest of the sentence being sent is gone. End the line, so that
+    // the next sentence doesn't continue it.
+    if (!client.at_line_start) {
+      client.owed_line_end = 2;
+      client.at_line_start = true;
+    }
+  }
+
+  if (client.owed_line_end > 0) {
+    const char* line_end = "\r\n" + (2 - client.owed_line_end);
+    ssize_t sent = send(client.fd, line_end, client.owed_line_end,
+                        MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    client.owed_line_end -= sent;
+    if (client.owed_line_end > 0) {
+      return true;
+    }
+  }
+
+  const uint8_t* data;
+  size_t length;
+  while ((length = ring_.peek(client.cursor, &data)) > 0) {
+    ssize_t sent = send(client.fd, data, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent < 0) {
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    if (sent > 0) {
+      client.cursor += sent;
+      client.at_line_start = data[sent - 1] == '\n';
+    }
+    if (static_cast<size_t>(sent) < length) {
+      break;
+    }
+  }
+  return true;
+}
+
+void NMEA0183TCPServer::poll() {
+  if (listen_fd_ < 0) {
+    return;
+  }
+  accept_clients();
+  backlog_ = 0;
+  for (Client& client : clients_) {
+    if (client.fd < 0) {
+      continue;
+    }
+    if (!serve(client)) {
+      close_client(client);
+      continue;
+    }
+    size_t backlog = ring_.backlog(client.cursor);
+    if (backlog > backlog_) {
+      backlog_ = backlog;
+    }
+  }
+  if (backlog_ > max_backlog_) {
+    max_backlog_ = backlog_;
+  }
+}
+
+}  // namespace sensesp::nmea0183
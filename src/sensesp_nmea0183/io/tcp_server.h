@@ -0,0 +1,115 @@
+#ifndef SENSESP_NMEA0183_TCP_SERVER_H_
+#define SENSESP_NMEA0183_TCP_SERVER_H_
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/io/sentence_ring.h"
+#include "sensesp_nmea0183/nmea0183.h"
+
+namespace sensesp::nmea0183 {
+
+/// The customary TCP port for NMEA 0183 data
+constexpr uint16_t kNMEA0183TCPPort = 10110;
+
+/// Most clients an NMEA0183TCPServer serves at once
+constexpr size_t kMaxTCPClients = 8;
+
+/// What to do with a client that has fallen so far behind that its unsent
+/// data has been overwritten
+enum class SlowClientPolicy : uint8_t {
+  skip,        // End the line being sent, continue from the oldest sentence
+  disconnect,  // Close the connection
+};
+
+/**
+ * @brief Serve a stream of sentences to TCP clients.
+ *
+ * Sentences are stored once in a SentenceRing and every client only keeps
+ * its position in the ring. Data is sent from the ring in place with
+ * non-blocking sends, on every event loop tick. The writer never waits for
+ * the clients; a client that can't keep up is handled by the
+ * SlowClientPolicy.
+ *
+ * A newly connected client receives the sentences written after it
+ * connected.
+ *
+ *   auto* server = new NMEA0183TCPServer();
+ *   server->start();
+ *   server->forward_from(nmea_io);
+ */
+class NMEA0183TCPServer {
+ public:
+  NMEA0183TCPServer(uint16_t port = kNMEA0183TCPPort,
+                    SlowClientPolicy policy = SlowClientPolicy::skip)
+      : port_{port}, policy_{policy} {}
+  ~NMEA0183TCPServer();
+
+  /**
+   * @brief Start listening.
+   *
+   * @param use_event_loop Call poll() on every event loop tick. Without it,
+   * poll() has to be called by the user.
+   * @return false if the socket could not be set up.
+   */
+  bool start(bool use_event_loop = true);
+  /// Close the listening socket and all client connections
+  void stop();
+
+  /// Serve the sentences read by io. Only sentences passing its address
+  /// filter are read; use NMEA0183Parser::allow_address("*") to serve all.
+  void forward_from(NMEA0183IO* io);
+  /// Serve a sentence without line ending
+  void write(const char* sentence) { ring_.push(sentence); }
+
+  /// Accept new clients and send them what they haven't received
+  void poll();
+
+  /// The port listened to, also when constructed with port 0
+  uint16_t get_port() const { return port_; }
+  size_t get_client_count() const;
+  /// Bytes not yet sent to the slowest client
+  size_t get_backlog() const { return backlog_; }
+  /// Highest backlog seen
+  size_t get_max_backlog() const { return max_backlog_; }
+  /// Number of times a slow client skipped data
+  unsigned int get_skip_count() const { return skip_count_; }
+  /// Number of slow clients disconnected
+  unsigned int get_dropped_client_count() const {
+    return dropped_client_count_;
+  }
+  /// Number of clients refused because kMaxTCPClients were connected
+  unsigned int get_rejected_client_count() const {
+    return rejected_client_count_;
+  }
+  const SentenceRing& ring() const { return ring_; }
+
+ protected:
+  struct Client {
+    int fd = -1;
+    uint32_t cursor = 0;
+    // False while a sentence has been sent in part
+    bool at_line_start = true;
+    // Bytes of the CR LF still owed for a line cut short by a skip
+    uint8_t owed_line_end = 0;
+  };
+
+  void accept_clients();
+  /// Send what the client can take. False if the connection was closed.
+  bool serve(Client& client);
+  void close_client(Client& client);
+
+  uint16_t port_;
+  SlowClientPolicy policy_;
+  int listen_fd_ = -1;
+  reactesp::Event* poll_event_ = nullptr;
+  SentenceRing ring_;
+  Client clients_[kMaxTCPClients];
+  size_t backlog_ = 0;
+  size_t max_backlog_ = 0;
+  unsigned int skip_count_ = 0;
+  unsigned int dropped_client_count_ = 0;
+  unsigned int rejected_client_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_TCP_SERVER_H_
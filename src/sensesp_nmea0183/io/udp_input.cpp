@@ -0,0 +1,100 @@
+#include "udp_input.h"
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "sensesp_nmea0183/io/socket_util.h"
+
+namespace sensesp::nmea0183 {
+
+NMEA0183UDPInput::NMEA0183UDPInput(uint16_t port)
+    : framer_{[this](const char* sentence) { parser_.parse(sentence); },
+              [this](const char* address, size_t length) {
+                return parser_.accepts_address(address, length);
+              }},
+      port_{port} {}
+
+NMEA0183UDPInput::NMEA0183UDPInput(uint16_t port, const SentenceFramer& framer)
+    : framer_{framer}, port_{port} {}
+
+NMEA0183UDPInput::~NMEA0183UDPInput() { stop(); }
+
+bool NMEA0183UDPInput::start(bool use_event_loop) {
+  fd_ = OpenBoundSocket(SOCK_DGRAM, &port_);
+  if (fd_ < 0) {
+    ESP_LOGW("SensESP/NMEA0183", "Can't receive on UDP port %u", port_);
+    return false;
+  }
+
+  if (use_event_loop && poll_event_ == nullptr) {
+    poll_event_ = event_loop()->onTick([this]() { poll(); });
+  }
+  return true;
+}
+
+void NMEA0183UDPInput::stop() {
+  if (poll_event_ != nullptr) {
+    event_loop()->remove(poll_event_);
+    poll_event_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+#ifdef __linux__
+int NMEA0183UDPInput::receive_batch() {
+  struct mmsghdr messages[kUDPReceiveBatchSize] = {};
+  struct iovec iovecs[kUDPReceiveBatchSize];
+  for (size_t i = 0; i < kUDPReceiveBatchSize; i++) {
+    iovecs[i].iov_base = buffers_[i];
+    iovecs[i].iov_len = kMaxNMEA0183DatagramSize;
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  int count = recvmmsg(fd_, messages, kUDPReceiveBatchSize, MSG_DONTWAIT,
+                       nullptr);
+  for (int i = 0; i < count; i++) {
+    if (messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+      truncated_count_++;
+    }
+    framer_.feed_packet(buffers_[i], messages[i].msg_len);
+  }
+  return count;
+}
+#else
+int NMEA0183UDPInput::receive_batch() {
+  struct iovec iovec = {buffers_[0], kMaxNMEA0183DatagramSize};
+  struct msghdr message = {};
+  message.msg_iov = &iovec;
+  message.msg_iovlen = 1;
+  ssize_t length = recvmsg(fd_, &message, MSG_DONTWAIT);
+  if (length < 0) {
+    return -1;
+  }
+  if (message.msg_flags & MSG_TRUNC) {
+    truncated_count_++;
+  }
+  framer_.feed_packet(buffers_[0], length);
+  return 1;
+}
+#endif
+
+void NMEA0183UDPInput::poll() {
+  if (fd_ < 0) {
+    return;
+  }
+  int count;
+  do {
+    count = receive_batch();
+    if (count > 0) {
+      receive_count_++;
+      datagram_count_ += count;
+    }
+    // A partial batch means the socket has been emptied
+  } while (count == static_cast<int>(kUDPReceiveBatchSize));
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,83 @@
+#ifndef SENSESP_NMEA0183_UDP_INPUT_H_
+#define SENSESP_NMEA0183_UDP_INPUT_H_
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/nmea0183.h"
+
+namespace sensesp::nmea0183 {
+
+/// The customary UDP port for NMEA 0183 broadcasts
+constexpr uint16_t kNMEA0183UDPPort = 10110;
+
+/// Largest datagram read whole: an Ethernet frame without IP and UDP headers
+constexpr size_t kMaxNMEA0183DatagramSize = 1472;
+
+/// Datagrams read per system call. Linux reads them with one recvmmsg();
+/// elsewhere they are read one at a time.
+#ifdef __linux__
+constexpr size_t kUDPReceiveBatchSize = 8;
+#else
+constexpr size_t kUDPReceiveBatchSize = 1;
+#endif
+
+/**
+ * @brief NMEA 0183 UDP input class.
+ *
+ * The UDP counterpart of NMEA0183IO: receives datagrams, such as those
+ * broadcast by multiplexers, and parses the sentences in them. The
+ * sentences are framed in the receive buffers with
+ * SentenceFramer::feed_packet(), without copying, and go through the same
+ * address filter and dispatch as the sentences of NMEA0183IO.
+ */
+class NMEA0183UDPInput {
+ public:
+  NMEA0183UDPInput(uint16_t port = kNMEA0183UDPPort);
+  /// Feed sentences to framer instead of parser_, e.g. one returned by
+  /// NMEA0183StaticParser::framer()
+  NMEA0183UDPInput(uint16_t port, const SentenceFramer& framer);
+  ~NMEA0183UDPInput();
+
+  NMEA0183Parser parser_;
+  SentenceFramer framer_;
+
+  /**
+   * @brief Start receiving.
+   *
+   * @param use_event_loop Call poll() on every event loop tick. Without it,
+   * poll() has to be called by the user.
+   * @return false if the socket could not be set up.
+   */
+  bool start(bool use_event_loop = true);
+  void stop();
+
+  /// Read and parse the datagrams received
+  void poll();
+
+  /// The port received on, also when constructed with port 0
+  uint16_t get_port() const { return port_; }
+  /// Number of datagrams received
+  unsigned int get_datagram_count() const { return datagram_count_; }
+  /// Number of receive calls that returned datagrams
+  unsigned int get_receive_count() const { return receive_count_; }
+  /// Number of datagrams longer than kMaxNMEA0183DatagramSize. Only the
+  /// first kMaxNMEA0183DatagramSize bytes of them are read.
+  unsigned int get_truncated_count() const { return truncated_count_; }
+
+ protected:
+  /// Receive up to kUDPReceiveBatchSize datagrams into buffers_ and frame
+  /// them. Returns the number received.
+  int receive_batch();
+
+  uint16_t port_;
+  int fd_ = -1;
+  reactesp::Event* poll_event_ = nullptr;
+  // One extra byte for the terminator written by feed_packet()
+  char buffers_[kUDPReceiveBatchSize][kMaxNMEA0183DatagramSize + 1];
+  unsigned int datagram_count_ = 0;
+  unsigned int receive_count_ = 0;
+  unsigned int truncated_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_UDP_INPUT_H_
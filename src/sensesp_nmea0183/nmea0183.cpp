@@ -2,7 +2,10 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 #include "sensesp.h"
+#include "sensesp_nmea0183/boot_report.h"
 
 namespace sensesp::nmea0183 {
 
@@ -46,11 +49,22 @@ int CalculateChecksum(const char* buffer, char seed) {
   return checksum;
 }
 
+bool AddressMatches(const char* address, size_t length, const char* pattern) {
+  size_t i;
+  for (i = 0; i < length && pattern[i] != 0; i++) {
+    if (pattern[i] != '.' && pattern[i] != address[i]) {
+      return false;
+    }
+  }
+  return i == length && pattern[i] == 0;
+}
+
 void AddChecksum(String& sentence) {
+  static const char kHexDigits[] = "0123456789ABCDEF";
   int checksum = CalculateChecksum(sentence.c_str());
-  char checksum_str[3];
-  sprintf(checksum_str, "%02X", checksum);
-  sentence += "*" + String(checksum_str);
+  char checksum_str[] = {'*', kHexDigits[(checksum >> 4) & 0x0F],
+                         kHexDigits[checksum & 0x0F], 0};
+  sentence += checksum_str;
 }
 
 void NMEA0183Parser::set(const String& line) {
@@ -59,13 +73,13 @@ void NMEA0183Parser::set(const String& line) {
   trimmed.trim();
 
   // Parse the sentence
-  parse_sentence(trimmed);
+  parse_sentence(trimmed.c_str());
   return;
 }
 
-void NMEA0183Parser::parse_sentence(const String& sentence) {
-  const char* sentence_str = sentence.c_str();
-  const char* tail = sentence.c_str();
+void NMEA0183Parser::parse_sentence(const char* sentence) {
+  const char* sentence_str = sentence;
+  const char* tail = sentence;
 
   // Check that the sentence starts with a dollar or an exclamation sign
   // (AIS sentences only)
@@ -76,18 +90,40 @@ void NMEA0183Parser::parse_sentence(const String& sentence) {
   tail++;
 
   // Loop through sentence parsers and find the one that matches the sentence.
+  // The sentence is split once, when the first parser matches its address,
+  // and parsers sharing the address are told apart by their discriminators.
 
+  SentenceFields fields;
+  bool split = false;
   for (auto parser : sentence_parsers) {
+    if (!parser->wanted()) {
+      continue;
+    }
     int address_length = strlen(parser->sentence_address());
     if (strncmpwc(tail, parser->sentence_address(), address_length) == 0) {
       // Check that the address field is followed by a comma
       if (tail[address_length] != ',') {
         continue;
       }
-      bool result = parser->parse(sentence_str);
+      if (!split) {
+        if (!fields.split(sentence_str)) {
+          return;
+        }
+        split = true;
+      }
+      if (!parser->accepts(fields)) {
+        continue;
+      }
+      bool result = parser->parse(fields);
       ESP_LOGV("SensESP/NMEA0183", "Parsed sentence %s with result %s",
                sentence_str, result ? "true" : "false");
-      if (result) return;
+      if (result) {
+        if (!first_sentence_reported_) {
+          BootReport::mark("First sentence parsed");
+          first_sentence_reported_ = true;
+        }
+        return;
+      }
     }
   }
   ESP_LOGV("SensESP/NMEA0183", "No parser found for sentence %s", sentence_str);
@@ -102,6 +138,116 @@ void ReportFailure(bool ok, const char* sentence) {
 
 void NMEA0183Parser::register_sentence_parser(SentenceParser* parser) {
   sentence_parsers.push_back(parser);
+  parser->set_lazy(lazy_);
+  // The address can't be read yet: the parser is still being constructed
+  address_filter_valid_ = false;
+}
+
+void NMEA0183Parser::set_lazy(bool lazy) {
+  lazy_ = lazy;
+  for (auto parser : sentence_parsers) {
+    parser->set_lazy(lazy);
+  }
+}
+
+void NMEA0183Parser::allow_address(const char* pattern) {
+  allowed_addresses_.push_back(pattern);
+  address_filter_valid_ = false;
+}
+
+void NMEA0183Parser::deny_address(const char* pattern) {
+  denied_addresses_.push_back(pattern);
+  address_filter_valid_ = false;
+}
+
+void NMEA0183Parser::update_address_filter() {
+  address_filter_.clear();
+  for (auto parser : sentence_parsers) {
+    if (parser->wanted()) {
+      address_filter_.add(parser->sentence_address());
+    }
+  }
+  for (const String& pattern : allowed_addresses_) {
+    if (pattern == "*") {
+      address_filter_.add_all();
+    } else {
+      address_filter_.add(pattern.c_str());
+    }
+  }
+  for (const String& pattern : denied_addresses_) {
+    address_filter_.deny(pattern.c_str());
+  }
+  address_filter_valid_ = true;
+}
+
+bool NMEA0183Parser::accepts_address(const char* address, size_t length) {
+  if (!address_filter_valid_) {
+    update_address_filter();
+  }
+  return address_filter_.accepts(address, length);
+}
+
+NMEA0183IO::NMEA0183IO(Stream* stream)
+    : framer_{[this](const char* sentence) {
+                for (auto& callback : sentence_callbacks_) {
+                  callback(sentence);
+                }
+                line_producer_->set(sentence);
+                parser_.parse(sentence);
+              },
+              [this](const char* address, size_t length) {
+                return parser_.accepts_address(address, length);
+              }},
+      stream_(stream) {
+  line_producer_->connect_to(sentence_filter_);
+  event_loop()->onAvailable(*stream_, [this]() { read_available(); });
+  event_loop()->onTick([this]() { write_queued(); });
+}
+
+NMEA0183IO::NMEA0183IO(Stream* stream, const SentenceFramer& framer)
+    : framer_{framer}, stream_(stream) {
+  line_producer_->connect_to(sentence_filter_);
+  event_loop()->onAvailable(*stream_, [this]() { read_available(); });
+  event_loop()->onTick([this]() { write_queued(); });
+}
+
+bool NMEA0183IO::write(const char* sentence, OutputPriority priority) {
+  if (sentence == nullptr) {
+    // E.g. a SentenceBuilder that ran out of space
+    return false;
+  }
+  if (!stream_reports_space_ && stream_->availableForWrite() > 0) {
+    stream_reports_space_ = true;
+  }
+  if (blocking_writes_ || !stream_reports_space_) {
+    stream_->println(sentence);
+    return true;
+  }
+  bool queued = output_queue_.push(sentence, priority);
+  write_queued();
+  return queued;
+}
+
+void NMEA0183IO::write_queued() {
+  if (!output_queue_.empty()) {
+    output_queue_.drain(stream_);
+  }
+}
+
+void NMEA0183IO::read_available() {
+  uint8_t buffer[64];
+  int available;
+  while ((available = stream_->available()) > 0) {
+    size_t length = stream_->readBytes(
+        buffer, std::min<size_t>(available, sizeof(buffer)));
+    if (length == 0) {
+      break;
+    }
+    if (capture_writer_ != nullptr) {
+      capture_writer_->write(capture_source_, buffer, length);
+    }
+    framer_.feed(buffer, length);
+  }
 }
 
 }  // namespace sensesp::nmea0183
@@ -2,28 +2,37 @@
 #define SENSESP_NMEA0183_NMEA0183_H_
 
 #include "sensesp/sensors/sensor.h"
-#include "sensesp/system/stream_producer.h"
 #include "sensesp/transforms/filter.h"
+#include "sensesp_nmea0183/data/sentence_builder.h"
+#include "sensesp_nmea0183/io/address_filter.h"
+#include "sensesp_nmea0183/io/capture.h"
+#include "sensesp_nmea0183/io/output_queue.h"
+#include "sensesp_nmea0183/io/sentence_framer.h"
+#include "sensesp_nmea0183/sentence_parser/sentence_fields.h"
 #include "sensesp_nmea0183/sentence_parser/sentence_parser.h"
 
 namespace sensesp::nmea0183 {
 
 void ReportFailure(bool ok, const char* sentence);
 
-/// Maximum length of a single NMEA sentence. The standard defined
-/// maximum is 82, but let's give it a bit of margin.
-constexpr int kNMEA0183InputBufferLength = 164;
-/// Maximum number of comma-separated fields in one NMEA sentence.
-constexpr int kNMEA0183MaxFields = 25;
+static_assert(kMaxFramedSentenceLength < kNMEA0183InputBufferLength,
+              "Framed sentences must fit the parser buffers");
 
 class SentenceParser;
 
 int CalculateChecksum(const char* buffer, char seed = 0);
+/// True if the address field of length characters matches pattern, which
+/// may contain '.' as a wildcard
+bool AddressMatches(const char* address, size_t length, const char* pattern);
 void AddChecksum(String& sentence);
 
 /**
  * @brief NMEA 0183 parser class.
  *
+ * Dispatches sentences to the registered sentence parsers. It also keeps the
+ * set of sentence addresses worth reading: those of the registered parsers
+ * that are wanted, see SentenceParser::wanted(), and of allow_address(),
+ * minus those of deny_address().
  **/
 class NMEA0183Parser : public ValueConsumer<String> {
  public:
@@ -31,12 +40,51 @@ class NMEA0183Parser : public ValueConsumer<String> {
 
   void register_sentence_parser(SentenceParser* parser);
   virtual void set(const String& line) override;
+  /// Parse a sentence without trailing whitespace
+  void parse(const char* sentence) { parse_sentence(sentence); }
+
+  /// Accept sentences with addresses matching pattern even if no parser
+  /// handles them. "*" accepts all sentences.
+  void allow_address(const char* pattern);
+  /// Reject sentences with addresses matching pattern
+  void deny_address(const char* pattern);
+  /// True if a sentence with this address field should be read
+  bool accepts_address(const char* address, size_t length);
+  /// Rebuild the address filter before its next use, e.g. because a parser
+  /// has become wanted
+  void invalidate_address_filter() { address_filter_valid_ = false; }
+
+  /// Make all registered parsers, and those registered later, lazy. See
+  /// SentenceParser::set_lazy().
+  void set_lazy(bool lazy);
 
  protected:
   // offset for each sentence field in the buffer
   int field_offsets[kNMEA0183MaxFields];
-  void parse_sentence(const String& sentence);
+  void parse_sentence(const char* sentence);
+  /// Rebuild address_filter_ if parsers, patterns or observers were added
+  void update_address_filter();
   std::vector<SentenceParser*> sentence_parsers;
+  std::vector<String> allowed_addresses_;
+  std::vector<String> denied_addresses_;
+  AddressFilter address_filter_;
+  bool address_filter_valid_ = false;
+  bool lazy_ = false;
+  bool first_sentence_reported_ = false;
+};
+
+/**
+ * @brief Producer of the sentences read by NMEA0183IO, as Strings.
+ *
+ * The String is reused from sentence to sentence, so it is only allocated
+ * again when a sentence is longer than all before it.
+ */
+class SentenceLineProducer : public ValueProducer<String> {
+ public:
+  void set(const char* sentence) {
+    this->output_ = sentence;
+    this->notify();
+  }
 };
 
 /**
@@ -44,29 +92,84 @@ class NMEA0183Parser : public ValueConsumer<String> {
  *
  * Reads NMEA 0183 sentences from a stream using the main event loop,
  * parses them, and allows writing sentences to the stream.
+ *
+ * Written sentences go through output_queue_ and are passed to the stream
+ * only as fast as it reports space with availableForWrite(), so a slow
+ * port doesn't block the event loop. Many streams don't implement
+ * availableForWrite() and always report 0; until a stream has reported
+ * space, sentences are written to it directly, waiting as println() does.
+ *
+ * Incoming bytes are framed into sentences in a fixed buffer. Sentences
+ * that the parser would not use, as decided by
+ * NMEA0183Parser::accepts_address(), are dropped as soon as their address
+ * field has been read.
  */
 class NMEA0183IO : public ValueConsumer<String> {
  public:
-  NMEA0183IO(Stream* stream) : stream_(stream) {
-    line_producer_ = std::make_shared<StreamLineProducer>(stream);
+  NMEA0183IO(Stream* stream);
+  /// Read sentences into framer instead of parser_, e.g. one returned by
+  /// NMEA0183StaticParser::framer()
+  NMEA0183IO(Stream* stream, const SentenceFramer& framer);
 
-    sentence_filter_ = std::make_shared<Filter<String>>([](const String& line) {
-      return line.startsWith("!") || line.startsWith("$");
-    });
-
-    line_producer_->connect_to(sentence_filter_)->connect_to(&parser_);
+  NMEA0183Parser parser_;
+  SentenceFramer framer_;
+  OutputQueue output_queue_;
+
+  /// @deprecated Use on_sentence(), which doesn't copy the sentences. Emits
+  /// the sentences read, which are only those the parser accepts; call
+  /// parser_.allow_address("*") to get all of them. To be removed in the
+  /// next release.
+  std::shared_ptr<SentenceLineProducer> line_producer_ =
+      std::make_shared<SentenceLineProducer>();
+  /// @deprecated Use on_sentence(). Emits the sentences of line_producer_
+  /// that start with '$' or '!', which all of them do. No longer feeds
+  /// parser_. To be removed in the next release.
+  std::shared_ptr<Filter<String>> sentence_filter_ =
+      std::make_shared<Filter<String>>([](const String& line) {
+        return line.startsWith("!") || line.startsWith("$");
+      });
+
+  /// Write a sentence, without line ending, with normal priority
+  virtual void set(const String& line) override {
+    write(line.c_str(), OutputPriority::normal);
   }
 
-  NMEA0183Parser parser_;
-  std::shared_ptr<StreamLineProducer> line_producer_;
-  std::shared_ptr<Filter<String>> sentence_filter_;
+  /// Queue a sentence without line ending, such as the result of
+  /// SentenceBuilder::finish(). False if it was dropped or nullptr.
+  bool write(const char* sentence,
+             OutputPriority priority = OutputPriority::normal);
 
-  virtual void set(const String& line) override {
-    stream_->println(line);
+  /// Write sentences directly to the stream, waiting until they have been
+  /// written, instead of queuing them, also if the stream reports space
+  void set_blocking_writes(bool blocking) { blocking_writes_ = blocking; }
+
+  /// Record every byte read from the stream, with its arrival time, as
+  /// coming from source. nullptr stops recording.
+  void capture_to(CaptureWriter* writer, uint8_t source = 0) {
+    capture_writer_ = writer;
+    capture_source_ = source;
+  }
+
+  /// Call callback with every sentence read, before it is parsed. The
+  /// sentence is valid during the call. Not called for sentences read into
+  /// a framer given to the constructor, and neither is line_producer_.
+  void on_sentence(SentenceFramer::SentenceFunction callback) {
+    sentence_callbacks_.push_back(callback);
   }
 
  protected:
+  /// Feed the bytes available in the stream to the framer
+  void read_available();
+  /// Write queued sentences while the stream has space
+  void write_queued();
+
   Stream* stream_;
+  bool blocking_writes_ = false;
+  // Set once availableForWrite() has returned more than 0
+  bool stream_reports_space_ = false;
+  std::vector<SentenceFramer::SentenceFunction> sentence_callbacks_;
+  CaptureWriter* capture_writer_ = nullptr;
+  uint8_t capture_source_ = 0;
 };
 
 /// @deprecated Use NMEA0183IO instead.
@@ -0,0 +1,55 @@
+#include "gnss_sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+bool RMCSentenceEncoder::encode_fields(SentenceBuilder& sentence) {
+  //      0         1 2         3 4          5 6   7   8      9   10 11
+  // $xxRMC,hhmmss.ss,A,ddmm.mmmm,N,dddmm.mmmm,E,x.x,x.x,ddmmyy,x.x,E,m*hh
+  const GNSSFix& fix = data_->fix.get();
+  bool has_position = fix.position.latitude != kInvalidDouble &&
+                      fix.position.longitude != kInvalidDouble;
+
+  // 0   UTC time
+  if (fix.datetime >= 0) {
+    sentence.add_time(fix.datetime);
+  } else {
+    sentence.add_time(0, 0, fix.utc_time);
+  }
+  // 1   Status
+  sentence.add_char(has_position ? 'A' : 'V');
+  // 2-5 Position
+  sentence.add_latitude(fix.position.latitude)
+      .add_longitude(fix.position.longitude);
+  // 6   Speed over ground, knots
+  sentence.add_float(
+      fix.speed == kInvalidFloat ? kInvalidFloat : fix.speed * kMsToKnots, 1);
+  // 7   Course over ground, degrees true
+  sentence.add_float(fix.true_course == kInvalidFloat
+                         ? kInvalidFloat
+                         : CompassDegrees(fix.true_course),
+                     1);
+  // 8   Date
+  if (fix.datetime >= 0) {
+    sentence.add_date(fix.datetime);
+  } else {
+    sentence.add_empty();
+  }
+  // 9-10 Magnetic variation, degrees
+  if (fix.variation == kInvalidFloat) {
+    sentence.add_empty().add_empty();
+  } else {
+    sentence.add_float(fabsf(fix.variation) * RAD_TO_DEG, 1)
+        .add_char(fix.variation < 0 ? 'W' : 'E');
+  }
+  // 11  Mode: autonomous, differential or not valid
+  char mode = 'A';
+  if (!has_position || fix.quality == 0) {
+    mode = 'N';
+  } else if (fix.quality == 2) {
+    mode = 'D';
+  }
+  sentence.add_char(mode);
+  return true;
+}
+
+}  // namespace sensesp::nmea0183
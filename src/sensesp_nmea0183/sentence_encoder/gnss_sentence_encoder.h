@@ -0,0 +1,34 @@
+#ifndef SENSESP_NMEA0183_GNSS_SENTENCE_ENCODER_H_
+#define SENSESP_NMEA0183_GNSS_SENTENCE_ENCODER_H_
+
+#include "sensesp_nmea0183/data/gnss_data.h"
+#include "sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Encoder for RMC - Recommended Minimum Specific GNSS Data.
+ *
+ * Encodes GNSSData::fix, so it needs a GNSSEpochAssembler feeding the data,
+ * as set up by ConnectGNSS(). The talker ID defaults to "GP".
+ */
+class RMCSentenceEncoder : public SentenceEncoder {
+ public:
+  RMCSentenceEncoder(NMEA0183Encoder* encoder, GNSSData* data,
+                     unsigned int interval_ms = 1000)
+      : SentenceEncoder(encoder, interval_ms, OutputPriority::normal),
+        data_{data} {
+    set_talker_id("GP");
+    observe(&data_->fix);
+  }
+  const char* sentence_formatter() override { return "RMC"; }
+
+ protected:
+  bool encode_fields(SentenceBuilder& sentence) override final;
+
+  GNSSData* data_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_GNSS_SENTENCE_ENCODER_H_
@@ -0,0 +1,30 @@
+#include "navigation_sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+bool HDTSentenceEncoder::encode_fields(SentenceBuilder& sentence) {
+  // $xxHDT,x.x,T*hh
+  float heading = data_->true_heading.get();
+  if (heading == kInvalidFloat) {
+    return false;
+  }
+  sentence.add_float(CompassDegrees(heading), 1).add_char('T');
+  return true;
+}
+
+bool DBTSentenceEncoder::encode_fields(SentenceBuilder& sentence) {
+  // $xxDBT,depth_feet,f,depth_meters,M,depth_fathoms,F*hh
+  float depth = data_->depth_below_transducer.get();
+  if (depth == kInvalidFloat) {
+    return false;
+  }
+  sentence.add_float(depth / 0.3048, 1)
+      .add_char('f')
+      .add_float(depth, 1)
+      .add_char('M')
+      .add_float(depth / 1.8288, 1)
+      .add_char('F');
+  return true;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,45 @@
+#ifndef SENSESP_NMEA0183_NAVIGATION_SENTENCE_ENCODER_H_
+#define SENSESP_NMEA0183_NAVIGATION_SENTENCE_ENCODER_H_
+
+#include "sensesp_nmea0183/data/navigation_data.h"
+#include "sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+/// Encoder for HDT - Heading, True
+class HDTSentenceEncoder : public SentenceEncoder {
+ public:
+  HDTSentenceEncoder(NMEA0183Encoder* encoder, HeadingData* data,
+                     unsigned int interval_ms = 100)
+      : SentenceEncoder(encoder, interval_ms, OutputPriority::high),
+        data_{data} {
+    observe(&data_->true_heading);
+  }
+  const char* sentence_formatter() override { return "HDT"; }
+
+ protected:
+  bool encode_fields(SentenceBuilder& sentence) override final;
+
+  HeadingData* data_;
+};
+
+/// Encoder for DBT - Depth Below Transducer
+class DBTSentenceEncoder : public SentenceEncoder {
+ public:
+  DBTSentenceEncoder(NMEA0183Encoder* encoder, DepthTemperatureData* data,
+                     unsigned int interval_ms = 1000)
+      : SentenceEncoder(encoder, interval_ms, OutputPriority::low),
+        data_{data} {
+    observe(&data_->depth_below_transducer);
+  }
+  const char* sentence_formatter() override { return "DBT"; }
+
+ protected:
+  bool encode_fields(SentenceBuilder& sentence) override final;
+
+  DepthTemperatureData* data_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_NAVIGATION_SENTENCE_ENCODER_H_
@@ -0,0 +1,88 @@
+#include "sentence_encoder.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "sensesp.h"
+
+namespace sensesp::nmea0183 {
+
+float CompassDegrees(float radians) {
+  float degrees = fmodf(radians * RAD_TO_DEG, 360);
+  return degrees < 0 ? degrees + 360 : degrees;
+}
+
+NMEA0183Encoder::NMEA0183Encoder(NMEA0183IO* io) : io_{io} {
+  event_loop()->onRepeat(kEncoderSchedulerIntervalMs,
+                         [this]() { send_due(); });
+}
+
+void NMEA0183Encoder::register_sentence_encoder(SentenceEncoder* encoder) {
+  sentence_encoders_.push_back(encoder);
+}
+
+void NMEA0183Encoder::send_due() {
+  unsigned long now = millis();
+  for (auto encoder : sentence_encoders_) {
+    encoder->send_if_due(now);
+  }
+}
+
+SentenceEncoder::SentenceEncoder(NMEA0183Encoder* encoder,
+                                 unsigned int interval_ms,
+                                 OutputPriority priority)
+    : encoder_{encoder}, interval_ms_{interval_ms}, priority_{priority} {
+  buffer_[0] = 0;
+  encoder_->register_sentence_encoder(this);
+}
+
+void SentenceEncoder::set_talker_id(const char* talker_id) {
+  strncpy(talker_id_, talker_id, 2);
+  talker_id_[2] = 0;
+  // The address is part of the encoded sentence
+  changed_ = true;
+}
+
+void SentenceEncoder::observe(Observable* observable) {
+  observable->attach([this]() { invalidate(); });
+}
+
+void SentenceEncoder::invalidate() {
+  changed_ = true;
+  has_input_ = true;
+  changed_at_ = millis();
+}
+
+void SentenceEncoder::encode() {
+  char address[6];
+  strcpy(address, talker_id_);
+  strncat(address, sentence_formatter(), 3);
+
+  SentenceBuilder sentence(buffer_, sizeof(buffer_));
+  sentence.start(address);
+  valid_ = encode_fields(sentence) && sentence.finish() != nullptr;
+  if (!valid_) {
+    ESP_LOGV("SensESP/NMEA0183", "Not sending %s", address);
+  }
+  changed_ = false;
+  encode_count_++;
+}
+
+void SentenceEncoder::send_if_due(unsigned long now) {
+  if (static_cast<long>(now - next_send_) < 0) {
+    return;
+  }
+  next_send_ = now + interval_ms_;
+  if (!has_input_ || (max_age_ms_ > 0 && now - changed_at_ > max_age_ms_)) {
+    return;
+  }
+  if (changed_) {
+    encode();
+  }
+  if (valid_) {
+    encoder_->io()->write(buffer_, priority_);
+    tx_count_++;
+  }
+}
+
+}  // namespace sensesp::nmea0183
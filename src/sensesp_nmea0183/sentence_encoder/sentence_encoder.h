@@ -0,0 +1,130 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_ENCODER_H_
+#define SENSESP_NMEA0183_SENTENCE_ENCODER_H_
+
+#include <vector>
+
+#include "sensesp/system/observable.h"
+#include "sensesp_nmea0183/data/sentence_builder.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/field_parsers.h"
+
+namespace sensesp::nmea0183 {
+
+/// Buffer size for an encoded sentence: the 82 characters NMEA 0183 allows,
+/// including the line ending, plus the terminator
+constexpr size_t kEncodedSentenceBufferLength = 83;
+
+/// Interval at which NMEA0183Encoder checks for due sentences, in ms
+constexpr unsigned int kEncoderSchedulerIntervalMs = 10;
+
+// Unit conversions of the encoders
+constexpr float kMsToKnots = 1 / 0.514444;
+constexpr float kMetersToNauticalMiles = 1 / 1852.0;
+
+/// Angle in radians as degrees in [0, 360)
+float CompassDegrees(float radians);
+
+class SentenceEncoder;
+
+/**
+ * @brief NMEA 0183 encoder class.
+ *
+ * The counterpart of NMEA0183Parser: schedules the registered sentence
+ * encoders and writes their sentences to an NMEA0183IO.
+ */
+class NMEA0183Encoder {
+ public:
+  NMEA0183Encoder(NMEA0183IO* io);
+
+  void register_sentence_encoder(SentenceEncoder* encoder);
+
+  /// Write the sentences that are due. Called from the event loop.
+  void send_due();
+
+  NMEA0183IO* io() const { return io_; }
+
+ protected:
+  NMEA0183IO* io_;
+  std::vector<SentenceEncoder*> sentence_encoders_;
+};
+
+/**
+ * @brief NMEA 0183 sentence encoder base class.
+ *
+ * Writes one sentence type at a fixed interval from observable values. The
+ * sentence is encoded into a fixed buffer only when one of the observed
+ * inputs has changed since it was last encoded; otherwise the previous
+ * sentence is sent again.
+ *
+ * Nothing is sent before the inputs have been set for the first time, or
+ * when they haven't changed for max_age_ms, so a receiver doesn't act on
+ * stale data. encode_fields() can also refuse to send by returning false,
+ * e.g. when a required value is invalid.
+ */
+class SentenceEncoder {
+ public:
+  /// Register with encoder and send every interval_ms
+  SentenceEncoder(NMEA0183Encoder* encoder, unsigned int interval_ms,
+                  OutputPriority priority = OutputPriority::normal);
+
+  /// Three-letter sentence formatter, e.g. "HDT"
+  virtual const char* sentence_formatter() = 0;
+
+  /// Two-letter talker ID of the sentences. Defaults to "II".
+  void set_talker_id(const char* talker_id);
+  void set_interval(unsigned int interval_ms) { interval_ms_ = interval_ms; }
+  void set_priority(OutputPriority priority) { priority_ = priority; }
+  /// Stop sending when the inputs haven't changed for max_age_ms. 0 sends
+  /// indefinitely.
+  void set_max_age(unsigned int max_age_ms) { max_age_ms_ = max_age_ms; }
+
+  /// Mark the inputs changed. Called by the observed inputs.
+  void invalidate();
+
+  /// Send the sentence if it is due at now
+  void send_if_due(unsigned long now);
+
+  /// The last encoded sentence, or nullptr if there is none
+  const char* get_sentence() const { return valid_ ? buffer_ : nullptr; }
+  /// Number of times the sentence was encoded
+  int get_encode_count() const { return encode_count_; }
+  /// Number of sentences passed to NMEA0183IO
+  int get_tx_count() const { return tx_count_; }
+
+ protected:
+  /**
+   * @brief Write the fields of the sentence after the address.
+   *
+   * @return false if the sentence can't be sent, e.g. because a required
+   * value is invalid.
+   */
+  virtual bool encode_fields(SentenceBuilder& sentence) = 0;
+
+  /// Re-encode the sentence when observable notifies. Called from the
+  /// constructors of the subclasses.
+  void observe(Observable* observable);
+
+  /// Encode the sentence into buffer_
+  void encode();
+
+  NMEA0183Encoder* encoder_;
+  unsigned int interval_ms_;
+  unsigned int max_age_ms_ = 5000;
+  OutputPriority priority_;
+  char talker_id_[3] = {'I', 'I', 0};
+  char buffer_[kEncodedSentenceBufferLength];
+  // The inputs changed after the last encoding
+  bool changed_ = false;
+  // buffer_ holds a sentence
+  bool valid_ = false;
+  // An input has been set
+  bool has_input_ = false;
+  unsigned long changed_at_ = 0;
+  unsigned long next_send_ = 0;
+  int encode_count_ = 0;
+  int tx_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_ENCODER_H_
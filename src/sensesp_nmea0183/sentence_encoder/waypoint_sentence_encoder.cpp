@@ -0,0 +1,23 @@
+#include "waypoint_sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+bool XTESentenceEncoder::encode_fields(SentenceBuilder& sentence) {
+  //      0 1 2   3 4 5
+  // $xxXTE,A,A,x.x,a,N,m*hh
+  // where 0 and 1 are status (A = valid), 2 is the cross-track error in
+  // nautical miles, 3 the direction to steer (L/R) and 5 the mode
+  float xte = data_->cross_track_error.get();
+  if (xte == kInvalidFloat) {
+    return false;
+  }
+  sentence.add_char('A')
+      .add_char('A')
+      .add_float(fabsf(xte) * kMetersToNauticalMiles, 3)
+      .add_char(xte < 0 ? 'L' : 'R')
+      .add_char('N')
+      .add_char('A');
+  return true;
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,29 @@
+#ifndef SENSESP_NMEA0183_WAYPOINT_SENTENCE_ENCODER_H_
+#define SENSESP_NMEA0183_WAYPOINT_SENTENCE_ENCODER_H_
+
+#include "sensesp_nmea0183/data/waypoint_data.h"
+#include "sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+/// Encoder for XTE - Cross-Track Error, Measured. A negative cross-track
+/// error is written as steer left, as the RMB and APB parsers read it.
+class XTESentenceEncoder : public SentenceEncoder {
+ public:
+  XTESentenceEncoder(NMEA0183Encoder* encoder, WaypointData* data,
+                     unsigned int interval_ms = 1000)
+      : SentenceEncoder(encoder, interval_ms, OutputPriority::high),
+        data_{data} {
+    observe(&data_->cross_track_error);
+  }
+  const char* sentence_formatter() override { return "XTE"; }
+
+ protected:
+  bool encode_fields(SentenceBuilder& sentence) override final;
+
+  WaypointData* data_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_WAYPOINT_SENTENCE_ENCODER_H_
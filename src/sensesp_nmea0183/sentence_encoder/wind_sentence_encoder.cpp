@@ -0,0 +1,20 @@
+#include "wind_sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+bool MWVSentenceEncoder::encode_fields(SentenceBuilder& sentence) {
+  // $xxMWV,a.a,R,s.s,N,A*hh
+  float angle = data_->angle.get();
+  float speed = data_->speed.get();
+  if (angle == kInvalidFloat || speed == kInvalidFloat) {
+    return false;
+  }
+  sentence.add_float(CompassDegrees(angle), 1)
+      .add_char('R')
+      .add_float(speed * kMsToKnots, 1)
+      .add_char('N')
+      .add_char('A');
+  return true;
+}
+
+}  // namespace sensesp::nmea0183
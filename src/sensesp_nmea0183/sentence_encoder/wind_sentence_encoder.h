@@ -0,0 +1,29 @@
+#ifndef SENSESP_NMEA0183_WIND_SENTENCE_ENCODER_H_
+#define SENSESP_NMEA0183_WIND_SENTENCE_ENCODER_H_
+
+#include "sensesp_nmea0183/data/wind_data.h"
+#include "sentence_encoder.h"
+
+namespace sensesp::nmea0183 {
+
+/// Encoder for MWV - Wind Speed and Angle, apparent wind in knots
+class MWVSentenceEncoder : public SentenceEncoder {
+ public:
+  MWVSentenceEncoder(NMEA0183Encoder* encoder, ApparentWindData* data,
+                     unsigned int interval_ms = 200)
+      : SentenceEncoder(encoder, interval_ms, OutputPriority::low),
+        data_{data} {
+    observe(&data_->angle);
+    observe(&data_->speed);
+  }
+  const char* sentence_formatter() override { return "MWV"; }
+
+ protected:
+  bool encode_fields(SentenceBuilder& sentence) override final;
+
+  ApparentWindData* data_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_WIND_SENTENCE_ENCODER_H_
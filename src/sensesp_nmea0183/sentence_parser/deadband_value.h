@@ -0,0 +1,100 @@
+#ifndef SENSESP_NMEA0183_DEADBAND_VALUE_H_
+#define SENSESP_NMEA0183_DEADBAND_VALUE_H_
+
+#include <math.h>
+
+#include "sensesp.h"
+#include "sentence_output.h"
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Change filtering of a parser output.
+ *
+ * The default settings forward every value.
+ */
+struct DeadbandSettings {
+  /// Changes smaller than this are suppressed (in the unit of the value)
+  float deadband = 0;
+  /// Values are rounded to a multiple of this, and values that round to the
+  /// last output are suppressed
+  float quantum = 0;
+  /// A suppressed value is output anyway if nothing was output for this
+  /// long, in ms. 0 disables the heartbeat.
+  unsigned int max_silence_ms = 0;
+};
+
+/**
+ * @brief Float parser output with deadband and quantization.
+ *
+ * Used for the parser outputs whose last digit jitters, so that a wiring
+ * helper can keep tiny changes off the network. Changes are measured against
+ * the last output value. Angular values are compared modulo 2π, so that a
+ * heading moving across north is not taken for a large change, and one
+ * that quantization rounds up to 2π is output as 0.
+ */
+class DeadbandValue : public SentenceOutput<float> {
+ public:
+  DeadbandValue(bool angular = false) : angular_{angular} {}
+
+  void set_settings(const DeadbandSettings& settings) { settings_ = settings; }
+  const DeadbandSettings& get_settings() const { return settings_; }
+
+  /// Number of values suppressed
+  unsigned int get_suppressed_count() const { return suppressed_count_; }
+
+  virtual void set(const float& value) override {
+    float new_value = value;
+    if (settings_.quantum > 0) {
+      new_value = roundf(new_value / settings_.quantum) * settings_.quantum;
+      // An angle rounded up to 2π is output as 0, e.g. 359.95° as 0°
+      if (angular_ && new_value > 2 * PI - settings_.quantum / 2) {
+        new_value -= 2 * PI;
+        if (fabsf(new_value) < settings_.quantum / 2) {
+          new_value = 0;
+        }
+      }
+    }
+    unsigned long now = millis();
+    if (has_output_ && !heartbeat_due(now) && !is_change(new_value)) {
+      suppressed_count_++;
+      return;
+    }
+    has_output_ = true;
+    last_output_ms_ = now;
+    SentenceOutput<float>::set(new_value);
+  }
+
+ protected:
+  bool heartbeat_due(unsigned long now) const {
+    return settings_.max_silence_ms > 0 &&
+           now - last_output_ms_ >= settings_.max_silence_ms;
+  }
+
+  bool is_change(float new_value) const {
+    float delta = fabsf(new_value - this->output_);
+    if (angular_) {
+      delta = fmodf(delta, 2 * PI);
+      if (delta > PI) {
+        delta = 2 * PI - delta;
+      }
+    }
+    if (settings_.deadband > 0 && delta < settings_.deadband) {
+      return false;
+    }
+    if (settings_.quantum > 0 && delta < settings_.quantum / 2) {
+      return false;
+    }
+    return true;
+  }
+
+  bool angular_;
+  DeadbandSettings settings_;
+  bool has_output_ = false;
+  unsigned long last_output_ms_ = 0;
+  unsigned int suppressed_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_DEADBAND_VALUE_H_
@@ -5,6 +5,8 @@
 
 #include <limits>
 
+#include "sensesp_nmea0183/data/fixed_string.h"
+
 namespace sensesp::nmea0183 {
 
 // magic values for invalid data
@@ -13,6 +15,17 @@ constexpr double kInvalidDouble = std::numeric_limits<double>::lowest();
 constexpr int kInvalidInt = std::numeric_limits<int>::lowest();
 
 bool ParseString(String* value, const char* s, bool allow_empty = false);
+/// Parse a string into a fixed-capacity string. A string longer than the
+/// capacity is rejected rather than truncated.
+template <size_t N>
+bool ParseString(FixedString<N>* value, const char* s,
+                 bool allow_empty = false) {
+  if (s[0] == 0) {
+    value->assign("");
+    return allow_empty;
+  }
+  return value->assign(s);
+}
 bool ParseInt(int* value, const char* s, bool allow_empty = false);
 bool ParseFloat(float* value, const char* s, bool allow_empty = false);
 bool ParseDouble(double* value, const char* s, bool allow_empty = false);
@@ -47,6 +60,21 @@ bool ConvertSpeedToMs(float* speed, char unit);
 #define FLDP_OPT(f, ...) \
   [&](const char* s) { return Parse##f(__VA_ARGS__ __VA_OPT__(, ) s, true); }
 
+// Field Parsers of fields read only if wanted is true, for outputs of lazy
+// parsers. Otherwise the field is parsed as if empty, which sets the
+// invalid value.
+
+#define FLDP_IF(wanted, f, ...)                                     \
+  [&](const char* s) {                                             \
+    return (wanted) ? Parse##f(__VA_ARGS__ __VA_OPT__(, ) s)        \
+                    : Parse##f(__VA_ARGS__ __VA_OPT__(, ) "", true); \
+  }
+
+#define FLDP_OPT_IF(wanted, f, ...)                                      \
+  [&](const char* s) {                                                  \
+    return Parse##f(__VA_ARGS__ __VA_OPT__(, )(wanted) ? s : "", true); \
+  }
+
 }  // namespace sensesp::nmea0183
 
 #endif  // SENSESP_NMEA0183_FIELD_PARSERS_H_
@@ -10,16 +10,23 @@ namespace sensesp::nmea0183 {
 
 using namespace std::placeholders;
 
-String gnss_quality_strings[] = {"no GPS",
-                                 "GNSS Fix",
-                                 "DGNSS fix",
-                                 "Precise GNSS",
-                                 "RTK fixed integer",
-                                 "RTK float",
-                                 "Estimated (DR) mode",
-                                 "Manual input",
-                                 "Simulator mode",
-                                 "Error"};
+const char* const gnss_quality_strings[] = {"no GPS",
+                                            "GNSS Fix",
+                                            "DGNSS fix",
+                                            "Precise GNSS",
+                                            "RTK fixed integer",
+                                            "RTK float",
+                                            "Estimated (DR) mode",
+                                            "Manual input",
+                                            "Simulator mode",
+                                            "Error"};
+
+InternedString GNSSQualityString(int quality) {
+  if (quality < 0 || quality > 8) {
+    return gnss_quality_strings[9];
+  }
+  return gnss_quality_strings[quality];
+}
 
 static bool ParseSkyTraqPSTI030Mode(SkyTraqGNSSQuality* quality,
                                     const char* s) {
@@ -83,36 +90,40 @@ bool GGASentenceParser::parse_fields(const char* field_strings,
     return false;
   }
 
+  // Fields of unwanted outputs are skipped; quality is always read, since
+  // it decides which of the other fields are published
+  bool want_position = position_.wanted();
+
   std::function<bool(const char*)> fps[] = {
       // 1    = UTC of Position
-      FLDP(Time, &hour, &minute, &second),
+      FLDP_IF(utc_time_.wanted(), Time, &hour, &minute, &second),
       // 2    = Latitude (empty when no fix)
-      FLDP_OPT(LatLon, &position.latitude),
+      FLDP_OPT_IF(want_position, LatLon, &position.latitude),
       // 3    = N or S
-      FLDP_OPT(NS, &position.latitude),
+      FLDP_OPT_IF(want_position, NS, &position.latitude),
       // 4    = Longitude (empty when no fix)
-      FLDP_OPT(LatLon, &position.longitude),
+      FLDP_OPT_IF(want_position, LatLon, &position.longitude),
       // 5    = E or W
-      FLDP_OPT(EW, &position.longitude),
+      FLDP_OPT_IF(want_position, EW, &position.longitude),
       // 6    = GPS quality indicator (0=invalid; 1=GPS fix; 2=Diff. GPS fix)
       FLDP(Int, &quality),
       // 7    = Number of satellites in use [not those in view]
-      FLDP(Int, &num_satellites),
+      FLDP_IF(num_satellites_.wanted(), Int, &num_satellites),
       // 8    = Horizontal dilution of position
-      FLDP_OPT(Float, &horizontal_dilution),
+      FLDP_OPT_IF(horizontal_dilution_.wanted(), Float, &horizontal_dilution),
       // 9    = Antenna altitude above/below mean sea level (geoid)
-      FLDP_OPT(Float, &position.altitude),
+      FLDP_OPT_IF(want_position, Float, &position.altitude),
       // 10   = Meters  (Antenna height unit)
       FLDP_OPT(Char, &antenna_height_unit, 'M'),
       // 11   = Geoidal separation (Diff. between WGS-84 earth ellipsoid and
       //        mean sea level.  -=geoid is below WGS-84 ellipsoid)
-      FLDP_OPT(Float, &geoidal_separation),
+      FLDP_OPT_IF(geoidal_separation_.wanted(), Float, &geoidal_separation),
       // 12   = Meters  (Units of geoidal separation)
       FLDP_OPT(Char, &geoidal_separation_unit, 'M'),
       // 13   = Age in seconds since last update from diff. reference station
-      FLDP_OPT(Float, &dgps_age),
+      FLDP_OPT_IF(dgps_age_.wanted(), Float, &dgps_age),
       // 14   = Diff. reference station ID#
-      FLDP_OPT(Int, &dgps_id)};
+      FLDP_OPT_IF(dgps_id_.wanted(), Int, &dgps_id)};
 
   for (int i = 1; i <= sizeof(fps) / sizeof(fps[0]); i++) {
     ok &= fps[i - 1](field_strings + field_offsets[i]);
@@ -124,12 +135,16 @@ bool GGASentenceParser::parse_fields(const char* field_strings,
 
   // notify relevant observers
 
+  if (hour != kInvalidInt) {
+    utc_time_.set(hour * 3600 + minute * 60 + second);
+  }
+
   if (position.latitude != kInvalidDouble &&
       position.longitude != kInvalidDouble) {
     position_.set(position);
   }
   if (quality != kInvalidInt) {
-    gnss_quality_.set(gnss_quality_strings[quality]);
+    gnss_quality_.set(GNSSQualityString(quality));
     quality_.set(quality);
   }
 
@@ -178,13 +193,22 @@ bool GLLSentenceParser::parse_fields(const char* field_strings,
       FLDP_OPT(LatLon, &position.longitude),
       // 4    W         East/West
       FLDP_OPT(EW, &position.longitude)
-      // ignore the UTC time of the fix and the status of the fix for now
+      // ignore the status of the fix for now
   };
 
   for (int i = 1; i <= sizeof(fps) / sizeof(fps[0]); i++) {
     ok &= fps[i - 1](field_strings + field_offsets[i]);
   }
 
+  // 5    225444    UTC time of the fix (absent in the oldest format)
+  int hour = kInvalidInt;
+  int minute = kInvalidInt;
+  float second = kInvalidFloat;
+  if (num_fields > 5) {
+    ok &= FLDP_OPT(Time, &hour, &minute, &second)(field_strings +
+                                                   field_offsets[5]);
+  }
+
   if (!ok) {
     return false;
   }
@@ -193,6 +217,9 @@ bool GLLSentenceParser::parse_fields(const char* field_strings,
 
   // notify relevant observers
 
+  if (hour != kInvalidInt) {
+    utc_time_.set(hour * 3600 + minute * 60 + second);
+  }
   if (position.latitude != kInvalidDouble &&
       position.longitude != kInvalidDouble) {
     position_.set(position);
@@ -224,29 +251,35 @@ bool RMCSentenceParser::parse_fields(const char* field_strings,
     return false;
   }
 
+  // Fields of unwanted outputs are skipped; validity is always read
+  bool want_position = position_.wanted();
+  bool want_variation = variation_.wanted();
+
   std::function<bool(const char*)> fps[] = {
       // 1   220516     Time Stamp
-      FLDP(Time, &time.tm_hour, &time.tm_min, &second),
+      FLDP_IF(utc_time_.wanted() || datetime_.wanted(), Time, &time.tm_hour,
+              &time.tm_min, &second),
       // 2   A          validity - A-ok, V-invalid
       FLDP(AV, &is_valid),
       // 3   5133.82    current Latitude (empty when V)
-      FLDP_OPT(LatLon, &position.latitude),
+      FLDP_OPT_IF(want_position, LatLon, &position.latitude),
       // 4   N          North/South
-      FLDP_OPT(NS, &position.latitude),
+      FLDP_OPT_IF(want_position, NS, &position.latitude),
       // 5   00042.24   current Longitude (empty when V)
-      FLDP_OPT(LatLon, &position.longitude),
+      FLDP_OPT_IF(want_position, LatLon, &position.longitude),
       // 6   W          East/West
-      FLDP_OPT(EW, &position.longitude),
+      FLDP_OPT_IF(want_position, EW, &position.longitude),
       // 7   173.8      Speed in knots (empty when stationary)
-      FLDP_OPT(Float, &speed),
+      FLDP_OPT_IF(speed_.wanted(), Float, &speed),
       // 8   231.8      True course (empty when stationary)
-      FLDP_OPT(Float, &true_course),
+      FLDP_OPT_IF(true_course_.wanted(), Float, &true_course),
       // 9   130694     Date Stamp
-      FLDP(Date, &time.tm_year, &time.tm_mon, &time.tm_mday),
+      FLDP_IF(datetime_.wanted(), Date, &time.tm_year, &time.tm_mon,
+              &time.tm_mday),
       // 10  004.2      Variation (empty on some receivers)
-      FLDP_OPT(Float, &variation),
+      FLDP_OPT_IF(want_variation, Float, &variation),
       // 11  W          East/West
-      FLDP_OPT(EW, &variation)
+      FLDP_OPT_IF(want_variation, EW, &variation)
 
       // Positioning system mode indicator might be available as field 12, but
       // let's ignore it for now.
@@ -266,6 +299,10 @@ bool RMCSentenceParser::parse_fields(const char* field_strings,
 
   // notify relevant observers
 
+  if (time.tm_hour != kInvalidInt) {
+    utc_time_.set(time.tm_hour * 3600 + time.tm_min * 60 + second);
+  }
+
   if (is_valid) {
     if (position.latitude != kInvalidDouble &&
         position.longitude != kInvalidDouble) {
@@ -351,19 +388,17 @@ bool GSVSentenceParser::parse_fields(const char* field_strings,
                                      int num_fields) {
   bool ok = true;
 
-  // True if NMEA 0183 v4.10 format with separate system ID is used
-  static int num_sentences = 0;
+  int num_sentences = 0;
   int sentence_number = 0;
-  static bool new_message_format = false;
-  static int collected_num_satellites = 0;
+  // True if NMEA 0183 v4.10 format with separate system ID is used
+  bool new_message_format = false;
   int num_satellites = 0;
-  static int total_svs_in_view = 0;  // Accumulated from field 3
-  static std::vector<GNSSSatellite> satellites;
-  GNSSSatellite sentence_satellites[4];
+  // Block fields as parsed, before packing into GNSSSatellite
+  int ids[4];
+  float elevations[4];
+  float azimuths[4];
+  int snrs[4];
   char signal_id = '0';
-  // (system, signal) types collected since the last cycle boundary.
-  static std::vector<int> seen_types;
-  String signal = "";
   GNSSSystem system = GNSSSystem::unknown;
 
   if (num_fields < 4 || num_fields > 21) {
@@ -418,13 +453,13 @@ bool GSVSentenceParser::parse_fields(const char* field_strings,
   for (int j = 0; j < num_blocks; j++) {
     std::function<bool(const char*)> rep_fps[] = {
         // 4   Satellite PRN number
-        FLDP_OPT(Int, &sentence_satellites[j].id),
+        FLDP_OPT(Int, &ids[j]),
         // 5   Elevation in degrees, 90 maximum
-        FLDP_OPT(Float, sentence_satellites[j].elevation.ptr()),
+        FLDP_OPT(Float, &elevations[j]),
         // 6   Azimuth, degrees from true north, 000 to 359
-        FLDP_OPT(Float, sentence_satellites[j].azimuth.ptr()),
+        FLDP_OPT(Float, &azimuths[j]),
         // 7   SNR, 00-99 dB (null when not tracking)
-        FLDP_OPT(Int, &sentence_satellites[j].snr),
+        FLDP_OPT(Int, &snrs[j]),
     };
 
     for (int i = 0; i < 4; i++) {
@@ -450,7 +485,7 @@ bool GSVSentenceParser::parse_fields(const char* field_strings,
     signal_id -= '0';
   }
 
-  int sentence_type = static_cast<int>(system) * 16 + signal_id;
+  uint8_t group = static_cast<uint8_t>(system) * 16 + signal_id;
 
   // Each (system, signal) group appears once per cycle, introduced by its
   // message 1. So the message 1 of a group already collected this cycle means
@@ -459,100 +494,141 @@ bool GSVSentenceParser::parse_fields(const char* field_strings,
   // anchor keeps this correct when the receiver's signal mix varies between
   // cycles or output starts mid-cycle.
 
+  // After a cycle has been emitted at its last group, a group that isn't
+  // part of the learned composition still belongs to that cycle: it arrived
+  // late. Keep it out of the next cycle, and wait for the wrap again, since
+  // the composition has changed.
+  if (sentence_number == 1) {
+    skipping_late_group_ = false;
+    if (emitted_early_) {
+      bool learned = false;
+      for (size_t i = 0; i < num_learned_groups_; i++) {
+        if (learned_groups_[i] == group) {
+          learned = true;
+          break;
+        }
+      }
+      if (!learned) {
+        late_group_ = group;
+        skipping_late_group_ = true;
+        late_group_count_++;
+        stable_cycles_ = 0;
+        return true;
+      }
+      emitted_early_ = false;
+    }
+  } else if (skipping_late_group_ && group == late_group_) {
+    return true;
+  }
+
   if (sentence_number == 1) {
     bool wrapped = false;
-    for (int t : seen_types) {
-      if (t == sentence_type) {
+    for (size_t i = 0; i < num_cycle_groups_; i++) {
+      if (cycle_groups_[i] == group) {
         wrapped = true;
         break;
       }
     }
     if (wrapped) {
-      num_satellites_.set(collected_num_satellites);
-      total_svs_in_view_.set(total_svs_in_view);
-      satellites_.set(satellites);
-      collected_num_satellites = 0;
-      total_svs_in_view = 0;
-      satellites.clear();
-      seen_types.clear();
+      emit_cycle();
+    }
+    if (composition_learned() &&
+        (num_cycle_groups_ >= num_learned_groups_ ||
+         learned_groups_[num_cycle_groups_] != group)) {
+      // The mix changed; wait for the wrap until it is learned again
+      stable_cycles_ = 0;
+    }
+    if (num_cycle_groups_ < kMaxGSVGroups) {
+      cycle_groups_[num_cycle_groups_++] = group;
+    } else {
+      ESP_LOGW("SensESP/NMEA0183", "Too many signal groups in GSV cycle");
     }
-    seen_types.push_back(sentence_type);
-    // Field 3 (SVs in view) is per (system, signal) group and repeats in
-    // every sentence of that group, so add it once per group, here at its
-    // message 1.
-    total_svs_in_view += num_satellites;
   }
 
-  // Names and IDs below copied from this document:
-  // https://docs.fixposition.com/fd/nmea-gp-gsv
-
-  if (new_message_format) {
-    switch (system) {
-      case GNSSSystem::gps:
-        switch (signal_id) {
-          case 1:
-            signal = "GPS L1 C/A";
-            break;
-          case 6:
-            signal = "GPS L2C-L";
-            break;
-          default:
-            signal = "unknown";
-        }
-        break;
-      case GNSSSystem::glonass:
-        switch (signal_id) {
-          case 1:
-            signal = "GLONASS G1 C/A";
-            break;
-          case 3:
-            signal = "GLONASS G2 C/A";
-            break;
-          default:
-            signal = "unknown";
-        }
-        break;
-      case GNSSSystem::galileo:
-        switch (signal_id) {
-          case 7:
-            signal = "Galileo L1-BC";
-            break;
-          case 2:
-            signal = "Galileo E5b";
-            break;
-          default:
-            signal = "unknown";
-        }
-        break;
-      case GNSSSystem::beidou:
-        switch (signal_id) {
-          case 1:
-            signal = "Beidou B1I";
-            break;
-          case 0xB:
-            signal = "Beidou B2I";
-            break;
-          default:
-            signal = "unknown";
-        }
-        break;
-      default:
-        signal = "unknown";
-    }
+  auto* assembly = assembler_.accept(group, num_sentences, sentence_number,
+                                     millis());
+  if (assembly == nullptr) {
+    // Out of sequence; the assembler counts it
+    return true;
   }
 
   // Collect the satellites in the sentence
 
   for (int i = 0; i < num_blocks; i++) {
-    sentence_satellites[i].system = system;
-    sentence_satellites[i].signal = signal;
-    satellites.push_back(sentence_satellites[i]);
-    collected_num_satellites++;
+    GNSSSatellite satellite;
+    satellite.system = system;
+    if (new_message_format) {
+      satellite.signal_id = signal_id;
+    }
+    if (ids[i] > 0 && ids[i] <= 0xFFFF) {
+      satellite.id = ids[i];
+    }
+    if (elevations[i] != kInvalidFloat) {
+      satellite.elevation = constrain(lroundf(elevations[i]), -90, 90);
+    }
+    if (azimuths[i] != kInvalidFloat) {
+      satellite.azimuth = constrain(lroundf(azimuths[i]), 0, 359);
+    }
+    if (snrs[i] != kInvalidInt) {
+      satellite.snr = constrain(snrs[i], 0, 254);
+    }
+    if (!assembler_.add(assembly, satellite)) {
+      ESP_LOGW("SensESP/NMEA0183", "Too many satellites in GSV group");
+      break;
+    }
+  }
+
+  if (!assembly->complete()) {
+    return true;
+  }
+
+  // Only complete groups join the cycle
+  for (size_t i = 0; i < assembly->size; i++) {
+    if (!cycle_tables_[collecting_].push_back(assembly->items[i])) {
+      ESP_LOGW("SensESP/NMEA0183", "Too many satellites in GSV cycle");
+      break;
+    }
+    collected_num_satellites_++;
+  }
+  assembler_.release(assembly);
+  // Field 3 (SVs in view) is per (system, signal) group and repeats in
+  // every sentence of that group, so add it once per group.
+  cycle_svs_in_view_ += num_satellites;
+
+  // With a learned composition, the last group completes the cycle.
+  if (composition_learned() && num_cycle_groups_ == num_learned_groups_ &&
+      cycle_groups_[num_cycle_groups_ - 1] == group) {
+    emit_cycle();
+    emitted_early_ = true;
   }
 
   return true;
 };
 
+void GSVSentenceParser::emit_cycle() {
+  num_satellites_.set(collected_num_satellites_);
+  total_svs_in_view_.set(cycle_svs_in_view_);
+  satellites_.set(&cycle_tables_[collecting_]);
+
+  bool same = num_cycle_groups_ == num_learned_groups_ &&
+              memcmp(cycle_groups_, learned_groups_, num_cycle_groups_) == 0;
+  if (same) {
+    if (stable_cycles_ < kGSVLearnCycles) {
+      stable_cycles_++;
+    }
+  } else {
+    memcpy(learned_groups_, cycle_groups_, num_cycle_groups_);
+    num_learned_groups_ = num_cycle_groups_;
+    stable_cycles_ = 1;
+  }
+
+  collected_num_satellites_ = 0;
+  cycle_svs_in_view_ = 0;
+  collecting_ ^= 1;
+  cycle_tables_[collecting_].clear();
+  num_cycle_groups_ = 0;
+}
+
 bool SkyTraqPSTI030SentenceParser::parse_fields(const char* field_strings,
                                                 const int field_offsets[],
                                                 int num_fields) {
@@ -640,7 +716,7 @@ bool SkyTraqPSTI030SentenceParser::parse_fields(const char* field_strings,
 
   // notify relevant observers
 
-  gnss_quality_.set(gnss_quality_strings[quality]);
+  gnss_quality_.set(GNSSQualityString(quality));
   rtk_age_.set(rtk_age);
   rtk_ratio_.set(rtk_ratio);
 
@@ -731,7 +807,7 @@ bool SkyTraqPSTI032SentenceParser::parse_fields(const char* field_strings,
     baseline_projection_.set(projection);
     baseline_length_.set(baseline_length);
     baseline_course_.set(2 * PI * baseline_course / 360.);
-    gnss_quality_.set(gnss_quality_strings[quality]);
+    gnss_quality_.set(GNSSQualityString(quality));
   }
 
   return true;
@@ -799,8 +875,7 @@ bool QuectelPQTMTARSentenceParser::parse_fields(const char* field_strings,
   time.tm_isdst = 0;
 
   datetime_.set(mktime(&time));
-  String quality = gnss_quality_strings[heading_status];
-  rtk_quality_.set(quality);
+  rtk_quality_.set(GNSSQualityString(heading_status));
   hdg_num_satellites_.set(hdg_num_satellites);
   if (heading_status == 4) {
     baseline_length_.set(base_line_length);
@@ -896,6 +971,7 @@ bool ZDASentenceParser::parse_fields(const char* field_strings,
   time.tm_year = year - 1900;  // tm_year is years since 1900
   time.tm_isdst = 0;
 
+  utc_time_.set(hour * 3600 + minute * 60 + second);
   datetime_.set(mktime(&time));
 
   return true;
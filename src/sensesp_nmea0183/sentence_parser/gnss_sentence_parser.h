@@ -6,6 +6,7 @@
 #include "sensesp/types/position.h"
 #include "sensesp_nmea0183/data/gnss_data.h"
 #include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/sentence_assembler.h"
 #include "sensesp_nmea0183/sentence_parser/sentence_parser.h"
 
 namespace sensesp::nmea0183 {
@@ -29,168 +30,273 @@ enum QuectelRTKHeadingStatus {
   dead_reckoning = 6,
 };
 
-extern String gnss_quality_strings[];
+extern const char* const gnss_quality_strings[];
+
+/// Interned description of a GGA quality indicator; "Error" if out of range.
+InternedString GNSSQualityString(int quality);
 
 /// Parser for GGA - Global Positioning System Fix Data.
 class GGASentenceParser : public SentenceParser {
  public:
-  GGASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  GGASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&utc_time_, &position_, &gnss_quality_, &quality_,
+                     &num_satellites_, &horizontal_dilution_,
+                     &geoidal_separation_, &dgps_age_, &dgps_id_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.GGA"; }
 
-  ObservableValue<Position> position_;
-  ObservableValue<String> gnss_quality_;
-  ObservableValue<int> quality_;  // Raw GGA quality indicator (0-8)
-  ObservableValue<int> num_satellites_;
-  ObservableValue<float> horizontal_dilution_;
-  ObservableValue<float> geoidal_separation_;
-  ObservableValue<float> dgps_age_;
-  ObservableValue<int> dgps_id_;
+  SentenceOutput<float> utc_time_;  // UTC time of fix, seconds since midnight
+  SentenceOutput<Position> position_;
+  SentenceOutput<InternedString> gnss_quality_;
+  SentenceOutput<int> quality_;  // Raw GGA quality indicator (0-8)
+  SentenceOutput<int> num_satellites_;
+  SentenceOutput<float> horizontal_dilution_;
+  SentenceOutput<float> geoidal_separation_;
+  SentenceOutput<float> dgps_age_;
+  SentenceOutput<int> dgps_id_;
 };
 
 /// Parser for GLL - Geographic position, latitude / longitude
 class GLLSentenceParser : public SentenceParser {
  public:
-  GLLSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  GLLSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&utc_time_, &position_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.GLL"; }
 
-  ObservableValue<Position> position_;
+  SentenceOutput<float> utc_time_;  // UTC time of fix, seconds since midnight
+  SentenceOutput<Position> position_;
 };
 
 /// Parser for RMC - Recommended minimum specific GPS/Transit data
 class RMCSentenceParser : public SentenceParser {
  public:
-  RMCSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  RMCSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&utc_time_, &position_, &datetime_, &speed_, &true_course_,
+                     &variation_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.RMC"; }
 
-  ObservableValue<Position> position_;
-  ObservableValue<time_t> datetime_;
-  ObservableValue<float> speed_;
-  ObservableValue<float> true_course_;
-  ObservableValue<float> variation_;
+  SentenceOutput<float> utc_time_;  // UTC time of fix, seconds since midnight
+  SentenceOutput<Position> position_;
+  SentenceOutput<time_t> datetime_;
+  SentenceOutput<float> speed_;
+  SentenceOutput<float> true_course_;
+  SentenceOutput<float> variation_;
 };
 
 /// Parser for VTG - Track made good and ground speed
 class VTGSentenceParser : public SentenceParser {
  public:
-  VTGSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  VTGSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&true_course_, &speed_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..VTG"; }
 
-  ObservableValue<float> true_course_;
-  ObservableValue<float> speed_;
+  SentenceOutput<float> true_course_;
+  SentenceOutput<float> speed_;
 };
 
-/// Parser for GSV - GNSS Satellites in View
+/// Most (system, signal) groups tracked per GSV cycle
+constexpr size_t kMaxGSVGroups = 16;
+/// Identical consecutive GSV cycles needed to learn the cycle composition
+constexpr int kGSVLearnCycles = 3;
+/// Most satellites in one (system, signal) group: 9 sentences of 4
+constexpr size_t kMaxGSVGroupSatellites = 36;
+/// A GSV group not completed within this time is abandoned
+constexpr uint32_t kGSVGroupTimeoutMs = 2000;
+
+/**
+ * @brief Parser for GSV - GNSS Satellites in View
+ *
+ * A GSV cycle is one group of sentences per (system, signal). Groups are
+ * reassembled with a SentenceAssembler, and only complete groups join the
+ * cycle. A cycle is emitted when the message 1 of a group already seen in
+ * it arrives. Once kGSVLearnCycles consecutive cycles had the same groups in
+ * the same order, that composition is learned and a cycle is emitted as
+ * soon as the last sentence of its last group arrives, instead of a cycle
+ * later. Any other group order drops the learned composition and falls back
+ * to the wrap. So does a group outside the learned composition arriving
+ * after such an early emission; it belongs to the emitted cycle and is
+ * dropped.
+ */
 class GSVSentenceParser : public SentenceParser {
  public:
-  GSVSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  GSVSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&num_satellites_, &total_svs_in_view_, &satellites_,
+                     &first_satellite_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.GSV"; }
 
+  /// True if cycles are emitted at their last sentence
+  bool composition_learned() const {
+    return stable_cycles_ >= kGSVLearnCycles;
+  }
+
+  /// Number of sentences ignored because they were out of sequence
+  unsigned int get_dropped_count() const {
+    return assembler_.get_dropped_count();
+  }
+  /// Number of groups left out of a cycle because sentences were missing
+  unsigned int get_partial_count() const {
+    return assembler_.get_partial_count();
+  }
+  /// Number of groups dropped for arriving after their cycle was emitted
+  unsigned int get_late_group_count() const { return late_group_count_; }
+
   /// Number of satellites with data blocks received in the GSV cycle
-  ObservableValue<int> num_satellites_;
+  SentenceOutput<int> num_satellites_;
   /// Sum of GSV field 3 (SVs in view) over the cycle's (system, signal)
   /// groups. Counts per signal like num_satellites_: a satellite tracked on
   /// several signals is counted once per signal.
-  ObservableValue<int> total_svs_in_view_;
-  ObservableValue<std::vector<GNSSSatellite>> satellites_;
-  ObservableValue<GNSSSatellite> first_satellite_;
+  SentenceOutput<int> total_svs_in_view_;
+  /// Satellites of the cycle. The table is owned by the parser and stays
+  /// unchanged until the next cycle is emitted.
+  SentenceOutput<const GNSSSatelliteTable*> satellites_{&cycle_tables_[1]};
+  SentenceOutput<GNSSSatellite> first_satellite_;
+
+ private:
+  /// Publish the collected cycle, learn its composition and start a new one
+  void emit_cycle();
+
+  SentenceAssembler<uint8_t, GNSSSatellite, kMaxGSVGroupSatellites, 2>
+      assembler_{kGSVGroupTimeoutMs};
+  int collected_num_satellites_ = 0;
+  int cycle_svs_in_view_ = 0;  // Accumulated from field 3
+  // The cycle being collected and the one last emitted. They swap roles on
+  // every emission, so the emitted table is never copied.
+  GNSSSatelliteTable cycle_tables_[2];
+  uint8_t collecting_ = 0;
+  // (system, signal) groups collected this cycle, in order of arrival
+  uint8_t cycle_groups_[kMaxGSVGroups];
+  size_t num_cycle_groups_ = 0;
+  // Groups of the previous cycle, or the learned composition
+  uint8_t learned_groups_[kMaxGSVGroups];
+  size_t num_learned_groups_ = 0;
+  int stable_cycles_ = 0;
+  // True from an emission at the last learned group until the next cycle's
+  // first learned group
+  bool emitted_early_ = false;
+  // Late group whose remaining sentences are being skipped
+  uint8_t late_group_ = 0;
+  bool skipping_late_group_ = false;
+  unsigned int late_group_count_ = 0;
 };
 
 /// Parser for SkyTraq proprietary STI,030 - Recommended Minimum 3D GNSS Data
 class SkyTraqPSTI030SentenceParser : public SentenceParser {
  public:
-  SkyTraqPSTI030SentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  SkyTraqPSTI030SentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&position_, &datetime_, &enu_velocity_, &gnss_quality_,
+                     &rtk_age_, &rtk_ratio_});
+  }
 
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
-  const char* sentence_address() override { return "PSTI,030"; }
-
-  ObservableValue<Position> position_;
-  ObservableValue<time_t> datetime_;
-  ObservableValue<ENUVector> enu_velocity_;
-  ObservableValue<String> gnss_quality_;
-  ObservableValue<float> rtk_age_;
-  ObservableValue<float> rtk_ratio_;
+  const char* sentence_address() override { return "PSTI"; }
+  SentenceDiscriminator discriminator() override { return {1, "030"}; }
+
+  SentenceOutput<Position> position_;
+  SentenceOutput<time_t> datetime_;
+  SentenceOutput<ENUVector> enu_velocity_;
+  SentenceOutput<InternedString> gnss_quality_;
+  SentenceOutput<float> rtk_age_;
+  SentenceOutput<float> rtk_ratio_;
 };
 
 /// Parser for SkyTraq proprietary STI,032 - RTK Baseline Data
 class SkyTraqPSTI032SentenceParser : public SentenceParser {
  public:
-  SkyTraqPSTI032SentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  SkyTraqPSTI032SentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&datetime_, &baseline_projection_, &baseline_length_,
+                     &baseline_course_, &gnss_quality_});
+  }
 
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
-  const char* sentence_address() override { return "PSTI,032"; }
-
-  ObservableValue<time_t> datetime_;
-  ObservableValue<ENUVector> baseline_projection_;
-  ObservableValue<float> baseline_length_;
-  ObservableValue<float> baseline_course_;
-  ObservableValue<String> gnss_quality_;
+  const char* sentence_address() override { return "PSTI"; }
+  SentenceDiscriminator discriminator() override { return {1, "032"}; }
+
+  SentenceOutput<time_t> datetime_;
+  SentenceOutput<ENUVector> baseline_projection_;
+  SentenceOutput<float> baseline_length_;
+  SentenceOutput<float> baseline_course_;
+  SentenceOutput<InternedString> gnss_quality_;
 };
 
 /// Parser for Quectel proprietary PQTMTAR - Time and Attitude
 class QuectelPQTMTARSentenceParser : public SentenceParser {
  public:
-  QuectelPQTMTARSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  QuectelPQTMTARSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&datetime_, &rtk_quality_, &baseline_length_, &attitude_,
+                     &attitude_accuracy_, &hdg_num_satellites_});
+  }
 
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "PQTMTAR"; }
 
-  ObservableValue<time_t> datetime_;
-  ObservableValue<String> rtk_quality_;
-  ObservableValue<float> baseline_length_;
-  ObservableValue<AttitudeVector> attitude_;
-  ObservableValue<AttitudeVector> attitude_accuracy_;
-  ObservableValue<int> hdg_num_satellites_;
+  SentenceOutput<time_t> datetime_;
+  SentenceOutput<InternedString> rtk_quality_;
+  SentenceOutput<float> baseline_length_;
+  SentenceOutput<AttitudeVector> attitude_;
+  SentenceOutput<AttitudeVector> attitude_accuracy_;
+  SentenceOutput<int> hdg_num_satellites_;
 };
 
 /// Parser for GSA - GPS DOP and Active Satellites
 class GSASentenceParser : public SentenceParser {
  public:
-  GSASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  GSASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&fix_type_, &pdop_, &hdop_, &vdop_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.GSA"; }
 
-  ObservableValue<int> fix_type_;     // 1=no fix, 2=2D, 3=3D
-  ObservableValue<float> pdop_;
-  ObservableValue<float> hdop_;
-  ObservableValue<float> vdop_;
+  SentenceOutput<int> fix_type_;     // 1=no fix, 2=2D, 3=3D
+  SentenceOutput<float> pdop_;
+  SentenceOutput<float> hdop_;
+  SentenceOutput<float> vdop_;
 };
 
 /// Parser for ZDA - Time & Date
 class ZDASentenceParser : public SentenceParser {
  public:
-  ZDASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  ZDASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&utc_time_, &datetime_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.ZDA"; }
 
-  ObservableValue<time_t> datetime_;
+  SentenceOutput<float> utc_time_;  // UTC time, seconds since midnight
+  SentenceOutput<time_t> datetime_;
 };
 
 /// Parser for GBS - GNSS Satellite Fault Detection
 class GBSSentenceParser : public SentenceParser {
  public:
-  GBSSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  GBSSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&lat_error_, &lon_error_, &alt_error_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "G.GBS"; }
 
-  ObservableValue<float> lat_error_;  // meters
-  ObservableValue<float> lon_error_;  // meters
-  ObservableValue<float> alt_error_;  // meters
+  SentenceOutput<float> lat_error_;  // meters
+  SentenceOutput<float> lon_error_;  // meters
+  SentenceOutput<float> alt_error_;  // meters
 };
 
 }  // namespace sensesp::nmea0183
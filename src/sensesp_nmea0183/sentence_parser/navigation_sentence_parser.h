@@ -1,6 +1,7 @@
 #ifndef SENSESP_NMEA0183_NAVIGATION_SENTENCE_PARSER_H_
 #define SENSESP_NMEA0183_NAVIGATION_SENTENCE_PARSER_H_
 
+#include "deadband_value.h"
 #include "field_parsers.h"
 #include "sensesp/system/observablevalue.h"
 #include "sensesp_nmea0183/nmea0183.h"
@@ -11,83 +12,97 @@ namespace sensesp::nmea0183 {
 /// Parser for HDG - Heading, Deviation & Variation
 class HDGSentenceParser : public SentenceParser {
  public:
-  HDGSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  HDGSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&magnetic_heading_, &deviation_, &variation_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..HDG"; }
 
-  ObservableValue<float> magnetic_heading_;  // radians
-  ObservableValue<float> deviation_;         // radians
-  ObservableValue<float> variation_;         // radians
+  SentenceOutput<float> magnetic_heading_;  // radians
+  SentenceOutput<float> deviation_;         // radians
+  SentenceOutput<float> variation_;         // radians
 };
 
 /// Parser for VHW - Water Speed and Heading
 class VHWSentenceParser : public SentenceParser {
  public:
-  VHWSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  VHWSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&true_heading_, &magnetic_heading_, &water_speed_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..VHW"; }
 
-  ObservableValue<float> true_heading_;      // radians
-  ObservableValue<float> magnetic_heading_;  // radians
-  ObservableValue<float> water_speed_;       // m/s
+  SentenceOutput<float> true_heading_;      // radians
+  SentenceOutput<float> magnetic_heading_;  // radians
+  SentenceOutput<float> water_speed_;       // m/s
 };
 
 /// Parser for DPT - Depth of Water
 class DPTSentenceParser : public SentenceParser {
  public:
-  DPTSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  DPTSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&depth_, &offset_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..DPT"; }
 
-  ObservableValue<float> depth_;   // meters (below transducer)
-  ObservableValue<float> offset_;  // meters (transducer offset)
+  SentenceOutput<float> depth_;   // meters (below transducer)
+  SentenceOutput<float> offset_;  // meters (transducer offset)
 };
 
 /// Parser for DBT - Depth Below Transducer
 class DBTSentenceParser : public SentenceParser {
  public:
-  DBTSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  DBTSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&depth_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..DBT"; }
 
-  ObservableValue<float> depth_;  // meters
+  DeadbandValue depth_;  // meters
 };
 
 /// Parser for MTW - Mean Temperature of Water
 class MTWSentenceParser : public SentenceParser {
  public:
-  MTWSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  MTWSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&water_temperature_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..MTW"; }
 
-  ObservableValue<float> water_temperature_;  // Kelvin
+  SentenceOutput<float> water_temperature_;  // Kelvin
 };
 
 /// Parser for HDM - Heading, Magnetic
 class HDMSentenceParser : public SentenceParser {
  public:
-  HDMSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  HDMSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&magnetic_heading_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..HDM"; }
 
-  ObservableValue<float> magnetic_heading_;  // radians
+  SentenceOutput<float> magnetic_heading_;  // radians
 };
 
 /// Parser for HDT - Heading, True
 class HDTSentenceParser : public SentenceParser {
  public:
-  HDTSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  HDTSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&true_heading_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..HDT"; }
 
-  ObservableValue<float> true_heading_;  // radians
+  DeadbandValue true_heading_{true};  // radians
 };
 
 }  // namespace sensesp::nmea0183
@@ -0,0 +1,167 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_ASSEMBLER_H_
+#define SENSESP_NMEA0183_SENTENCE_ASSEMBLER_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Reassembly of "sentence N of M" groups.
+ *
+ * Sentences such as GSV and RTE carry the number of sentences in their group
+ * and their own number in it. Each group is identified by a Key and collects
+ * up to kMaxItems Items from its sentences into a fixed slot; kMaxGroups
+ * groups can be in progress at once, for talkers that interleave groups.
+ *
+ * A group in progress expects its sentences in order. Message 1 (re)starts
+ * the group; any other sentence must be the next one of its group with the
+ * same sentence count, otherwise the group is abandoned. Groups not completed
+ * within the timeout are abandoned too.
+ *
+ * Typical use from parse_fields():
+ *
+ *   auto* group = assembler_.accept(key, num_sentences, sentence_number,
+ *                                   millis());
+ *   if (group == nullptr) return true;  // out of sequence, counted
+ *   ...assembler_.add(group, item)...
+ *   if (group->complete()) { ...emit group->items...; assembler_.release(group); }
+ */
+template <typename Key, typename Item, size_t kMaxItems, size_t kMaxGroups = 1>
+class SentenceAssembler {
+ public:
+  struct Group {
+    Key key;
+    int num_sentences = 0;
+    int next_sentence = 0;  // 0 if the slot is free
+    uint32_t started_ms = 0;
+    size_t size = 0;
+    Item items[kMaxItems];
+
+    bool active() const { return next_sentence > 0; }
+    bool complete() const { return next_sentence > num_sentences; }
+  };
+
+  SentenceAssembler(uint32_t timeout_ms) : timeout_ms_{timeout_ms} {}
+
+  /**
+   * @brief Account for sentence sentence_number of num_sentences of group key.
+   *
+   * @return The group to add the items of the sentence to, or nullptr if the
+   * sentence does not continue a group and must be ignored.
+   */
+  Group* accept(const Key& key, int num_sentences, int sentence_number,
+                uint32_t now_ms) {
+    expire(now_ms);
+
+    if (num_sentences < 1 || sentence_number < 1 ||
+        sentence_number > num_sentences) {
+      dropped_count_++;
+      return nullptr;
+    }
+
+    Group* group = find(key);
+    if (sentence_number == 1) {
+      if (group != nullptr) {
+        abandon(group);
+      } else {
+        group = free_slot();
+        if (group == nullptr) {
+          dropped_count_++;
+          return nullptr;
+        }
+      }
+      group->key = key;
+      group->num_sentences = num_sentences;
+      group->started_ms = now_ms;
+      group->size = 0;
+    } else if (group == nullptr) {
+      // The group's start was missed
+      dropped_count_++;
+      return nullptr;
+    } else if (group->num_sentences != num_sentences ||
+               group->next_sentence != sentence_number) {
+      abandon(group);
+      dropped_count_++;
+      return nullptr;
+    }
+
+    group->next_sentence = sentence_number + 1;
+    if (group->complete()) {
+      completed_count_++;
+    }
+    return group;
+  }
+
+  /// Add an item to a group. Returns false if the group is full.
+  bool add(Group* group, const Item& item) {
+    if (group->size >= kMaxItems) {
+      return false;
+    }
+    group->items[group->size++] = item;
+    return true;
+  }
+
+  /// Free the slot of a group once its contents have been used
+  void release(Group* group) { group->next_sentence = 0; }
+
+  /// Abandon groups older than the timeout
+  void expire(uint32_t now_ms) {
+    for (size_t i = 0; i < kMaxGroups; i++) {
+      if (groups_[i].active() && !groups_[i].complete() &&
+          now_ms - groups_[i].started_ms > timeout_ms_) {
+        abandon(&groups_[i]);
+      }
+    }
+  }
+
+  /// Number of groups completed
+  unsigned int get_completed_count() const { return completed_count_; }
+  /// Number of sentences ignored because they did not continue a group
+  unsigned int get_dropped_count() const { return dropped_count_; }
+  /// Number of groups abandoned before they were complete
+  unsigned int get_partial_count() const { return partial_count_; }
+
+ protected:
+  Group* find(const Key& key) {
+    for (size_t i = 0; i < kMaxGroups; i++) {
+      if (groups_[i].active() && groups_[i].key == key) {
+        return &groups_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  /// A free slot, or else the oldest one if its group is complete
+  Group* free_slot() {
+    Group* oldest = nullptr;
+    for (size_t i = 0; i < kMaxGroups; i++) {
+      if (!groups_[i].active()) {
+        return &groups_[i];
+      }
+      if (oldest == nullptr || groups_[i].started_ms < oldest->started_ms) {
+        oldest = &groups_[i];
+      }
+    }
+    if (oldest != nullptr && oldest->complete()) {
+      return oldest;
+    }
+    return nullptr;
+  }
+
+  void abandon(Group* group) {
+    if (!group->complete()) {
+      partial_count_++;
+    }
+    group->next_sentence = 0;
+  }
+
+  Group groups_[kMaxGroups];
+  uint32_t timeout_ms_;
+  unsigned int completed_count_ = 0;
+  unsigned int dropped_count_ = 0;
+  unsigned int partial_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_ASSEMBLER_H_
@@ -0,0 +1,41 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_FIELDS_H_
+#define SENSESP_NMEA0183_SENTENCE_FIELDS_H_
+
+#include <Arduino.h>
+
+namespace sensesp::nmea0183 {
+
+/// Maximum length of a single NMEA sentence. The standard defined
+/// maximum is 82, but let's give it a bit of margin.
+constexpr int kNMEA0183InputBufferLength = 164;
+/// Maximum number of comma-separated fields in one NMEA sentence.
+constexpr int kNMEA0183MaxFields = 25;
+
+/**
+ * @brief A sentence split into its fields.
+ *
+ * A sentence is split once and the result shared by all the parsers it is
+ * dispatched to.
+ */
+struct SentenceFields {
+  /// The sentence as received
+  const char* sentence = nullptr;
+  /// A copy of the sentence with the commas and the checksum delimiter
+  /// replaced with 0s. The sentence start character and the sentence
+  /// address are in the zeroth field.
+  char strings[kNMEA0183InputBufferLength];
+  /// Offset of the beginning of each field in strings
+  int offsets[kNMEA0183MaxFields] = {0};
+  int num_fields = 0;
+  /// True if the sentence has a checksum and it matches
+  bool checksum_valid = false;
+
+  const char* field(int i) const { return strings + offsets[i]; }
+
+  /// Split sentence. Returns false if it has too many fields.
+  bool split(const char* sentence);
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_FIELDS_H_
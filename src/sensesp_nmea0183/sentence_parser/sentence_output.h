@@ -0,0 +1,245 @@
+#ifndef SENSESP_NMEA0183_SENTENCE_OUTPUT_H_
+#define SENSESP_NMEA0183_SENTENCE_OUTPUT_H_
+
+#include "sensesp/system/observable.h"
+#include "sensesp/system/observablevalue.h"
+
+namespace sensesp::nmea0183 {
+
+class SentenceBatch;
+class SentenceCoalescer;
+class SentenceParser;
+
+/**
+ * @brief Type independent part of SentenceOutput, linked into a SentenceBatch
+ * while staged.
+ */
+class SentenceOutputBase {
+ public:
+  virtual ~SentenceOutputBase() {}
+
+  /// True if an observer was attached or a consumer connected
+  bool observed() const { return observed_; }
+  /**
+   * @brief Treat the output as observed.
+   *
+   * Needed for an output whose value is only read with get(), for example
+   * from an observer of its parser, when the parser is lazy.
+   */
+  void set_observed();
+  /// True if the output has to be parsed and set: the parser is not lazy or
+  /// the output is observed
+  bool wanted() const;
+
+ protected:
+  friend class SentenceBatch;
+  friend class SentenceParser;
+
+  /// Make the staged value the current one, without notifying
+  virtual void commit() = 0;
+  /// Notify the observers of the current value
+  virtual void publish() = 0;
+
+  bool staged_ = false;
+  SentenceOutputBase* next_staged_ = nullptr;
+  bool observed_ = false;
+  // The parser that declared this output, or nullptr
+  SentenceParser* parser_ = nullptr;
+};
+
+/**
+ * @brief The outputs set while one sentence is being parsed.
+ *
+ * While a batch is active, SentenceOutput::set() only stages the value. When
+ * the sentence has been parsed, publish() first updates all staged outputs
+ * and then notifies their observers in the order the outputs were set, so
+ * every observer sees the complete sentence, and then runs each
+ * SentenceCoalescer notified by them once. discard() drops the staged
+ * values of a sentence that failed to parse.
+ *
+ * Staged outputs and coalescers are kept in intrusive lists, so a batch
+ * needs no allocation.
+ */
+class SentenceBatch {
+ public:
+  /// The batch being filled, or nullptr
+  static SentenceBatch* active() { return active_; }
+  /// The batch whose outputs are notifying their observers, or nullptr
+  static SentenceBatch* publishing() { return publishing_; }
+
+  void begin() {
+    previous_ = active_;
+    active_ = this;
+  }
+
+  void stage(SentenceOutputBase* output) {
+    if (output->staged_) {
+      return;
+    }
+    output->staged_ = true;
+    output->next_staged_ = nullptr;
+    if (tail_ == nullptr) {
+      head_ = output;
+    } else {
+      tail_->next_staged_ = output;
+    }
+    tail_ = output;
+  }
+
+  /// Run coalescer once when the outputs have been notified
+  void defer(SentenceCoalescer* coalescer);
+
+  void publish();
+
+  void discard() {
+    end();
+    for (SentenceOutputBase* o = head_; o != nullptr; o = o->next_staged_) {
+      o->staged_ = false;
+    }
+    head_ = tail_ = nullptr;
+  }
+
+ protected:
+  void end() { active_ = previous_; }
+
+  static inline SentenceBatch* active_ = nullptr;
+  static inline SentenceBatch* publishing_ = nullptr;
+  SentenceBatch* previous_ = nullptr;
+  SentenceOutputBase* head_ = nullptr;
+  SentenceOutputBase* tail_ = nullptr;
+  SentenceCoalescer* deferred_head_ = nullptr;
+  SentenceCoalescer* deferred_tail_ = nullptr;
+};
+
+/**
+ * @brief Observable output of a sentence parser.
+ *
+ * Behaves as an ObservableValue, except that a value set while a
+ * SentenceBatch is active is held back until the whole sentence has been
+ * parsed.
+ *
+ * attach() and connect_to() mark the output as observed. An unobserved
+ * output of a lazy parser ignores set(). Observers attached through a
+ * ValueProducer or Observable reference are not seen; use set_observed()
+ * for those.
+ */
+template <typename T>
+class SentenceOutput : public ObservableValue<T>, public SentenceOutputBase {
+ public:
+  SentenceOutput() = default;
+  SentenceOutput(const T& value) : ObservableValue<T>(value) {}
+
+  void attach(std::function<void()> observer) {
+    set_observed();
+    ObservableValue<T>::attach(observer);
+  }
+
+  template <typename VConsumer>
+  auto connect_to(VConsumer&& consumer) {
+    set_observed();
+    return ObservableValue<T>::connect_to(std::forward<VConsumer>(consumer));
+  }
+
+  virtual void set(const T& value) override {
+    if (!wanted()) {
+      return;
+    }
+    SentenceBatch* batch = SentenceBatch::active();
+    if (batch == nullptr) {
+      ObservableValue<T>::set(value);
+      return;
+    }
+    staged_value_ = value;
+    batch->stage(this);
+  }
+
+ protected:
+  void commit() override { this->output_ = staged_value_; }
+  void publish() override { this->notify(); }
+
+  T staged_value_{};
+};
+
+/**
+ * @brief Notify once per sentence that set any of several outputs.
+ *
+ * For observers that combine outputs of a parser, such as a transform
+ * computing from both the angle and the speed of an MWV sentence, which
+ * would otherwise run once for every output set. With a batching parser,
+ * the observers of the coalescer run once per sentence, after the observers
+ * of the outputs. Without batching, they run whenever a watched output is
+ * set.
+ *
+ *   SentenceCoalescer* wind = new SentenceCoalescer();
+ *   wind->watch(&mwv->apparent_wind_angle_);
+ *   wind->watch(&mwv->apparent_wind_speed_);
+ *   wind->attach([mwv]() { ... });
+ */
+class SentenceCoalescer : public Observable {
+ public:
+  /// Notify when output is set. Marks the output as observed.
+  template <typename T>
+  void watch(SentenceOutput<T>* output) {
+    output->attach([this]() { changed(); });
+  }
+
+ protected:
+  friend class SentenceBatch;
+
+  void changed() {
+    SentenceBatch* batch = SentenceBatch::publishing();
+    if (batch == nullptr) {
+      notify();
+      return;
+    }
+    batch->defer(this);
+  }
+
+  bool deferred_ = false;
+  SentenceCoalescer* next_deferred_ = nullptr;
+};
+
+inline void SentenceBatch::defer(SentenceCoalescer* coalescer) {
+  if (coalescer->deferred_) {
+    return;
+  }
+  coalescer->deferred_ = true;
+  coalescer->next_deferred_ = nullptr;
+  if (deferred_tail_ == nullptr) {
+    deferred_head_ = coalescer;
+  } else {
+    deferred_tail_->next_deferred_ = coalescer;
+  }
+  deferred_tail_ = coalescer;
+}
+
+inline void SentenceBatch::publish() {
+  end();
+  for (SentenceOutputBase* o = head_; o != nullptr; o = o->next_staged_) {
+    o->commit();
+  }
+  SentenceBatch* outer = publishing_;
+  publishing_ = this;
+  SentenceOutputBase* o = head_;
+  head_ = tail_ = nullptr;
+  while (o != nullptr) {
+    SentenceOutputBase* next = o->next_staged_;
+    o->staged_ = false;
+    o->publish();
+    o = next;
+  }
+  publishing_ = outer;
+
+  SentenceCoalescer* c = deferred_head_;
+  deferred_head_ = deferred_tail_ = nullptr;
+  while (c != nullptr) {
+    SentenceCoalescer* next = c->next_deferred_;
+    c->deferred_ = false;
+    c->notify();
+    c = next;
+  }
+}
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SENTENCE_OUTPUT_H_
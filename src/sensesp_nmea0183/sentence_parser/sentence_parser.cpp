@@ -4,57 +4,86 @@
 
 namespace sensesp::nmea0183 {
 
-SentenceParser::SentenceParser(NMEA0183Parser* nmea_io) : ignore_checksum_{false} {
-  nmea_io->register_sentence_parser(this);
+SentenceParser::SentenceParser(NMEA0183Parser* nmea_io)
+    : nmea_{nmea_io}, ignore_checksum_{false} {
+  if (nmea_io != nullptr) {
+    nmea_io->register_sentence_parser(this);
+  }
 }
 
-bool SentenceParser::parse(const char* buffer) {
-  if (!ignore_checksum_) {
-    if (!validate_checksum(buffer)) {
-      ESP_LOGW("SensESP/NMEA0183", "Invalid checksum in sentence: %s", buffer);
-      return false;
-    }
+void SentenceParser::declare_outputs(
+    std::initializer_list<SentenceOutputBase*> outputs) {
+  for (SentenceOutputBase* output : outputs) {
+    output->parser_ = this;
+    observed_ |= output->observed_;
   }
+  outputs_declared_ = true;
+  wanted_changed();
+}
 
-  char field_strings[kNMEA0183InputBufferLength];
-  strncpy(field_strings, buffer, kNMEA0183InputBufferLength);
-  field_strings[kNMEA0183InputBufferLength - 1] = 0;
+void SentenceParser::set_lazy(bool lazy) {
+  if (lazy != lazy_) {
+    lazy_ = lazy;
+    wanted_changed();
+  }
+}
 
-  int i;
-  int checksum_location = -1;
-
-  if (!ignore_checksum_) {
-    // Remove the checksum from field_strings
-    for (i = 0; field_strings[i] != 0; i++) {
-      if (field_strings[i] == '*') {
-        field_strings[i] = 0;
-        break;
-      }
-    }
+void SentenceParser::set_observed() {
+  if (!observed_) {
+    observed_ = true;
+    wanted_changed();
   }
+}
 
-  // The first field starts at the beginning of the buffer
-  int field_offsets[kNMEA0183MaxFields] = {0};
-
-  // Split the sentence into fields. field_strings is otherwise a copy
-  // of buffer, but the commas are replaced with 0s. field_offsets
-  // contains the offsets of the beginning of each field in buffer.
-  // Since the first field starts after the first comma,
-  // the first field offset is 1. The sentence start character and the
-  // sentence name are in the zeroth field.
-
-  int num_fields = 0;
-  for (i = 0; field_strings[i] != 0; i++) {
-    if (num_fields >= kNMEA0183MaxFields) {
-      ESP_LOGW("SensESP/NMEA0183", "Too many fields in sentence: %s", buffer);
-      return false;
-    }
-    if (field_strings[i] == ',') {
+void SentenceParser::wanted_changed() {
+  if (nmea_ != nullptr) {
+    nmea_->invalidate_address_filter();
+  }
+}
+
+void SentenceOutputBase::set_observed() {
+  observed_ = true;
+  if (parser_ != nullptr) {
+    parser_->set_observed();
+  }
+}
+
+bool SentenceOutputBase::wanted() const {
+  return observed_ || parser_ == nullptr || !parser_->lazy_;
+}
+
+bool SentenceFields::split(const char* buffer) {
+  sentence = buffer;
+  strncpy(strings, buffer, kNMEA0183InputBufferLength);
+  strings[kNMEA0183InputBufferLength - 1] = 0;
+
+  // Split the sentence into fields. strings is otherwise a copy of buffer,
+  // but the commas are replaced with 0s, and the checksum is cut off at the
+  // '*'. offsets contains the offsets of the beginning of each field in
+  // strings. Since the first field starts after the first comma, the first
+  // field offset is 1. The sentence start character and the sentence name
+  // are in the zeroth field.
+
+  int i;
+  const char* checksum = nullptr;
+  num_fields = 0;
+  offsets[0] = 0;
+  for (i = 0; strings[i] != 0; i++) {
+    if (strings[i] == ',') {
+      if (num_fields + 1 >= kNMEA0183MaxFields) {
+        ESP_LOGW("SensESP/NMEA0183", "Too many fields in sentence: %s",
+                 buffer);
+        return false;
+      }
       num_fields++;
-      field_strings[i] = 0;
-      field_offsets[num_fields] = i + 1;
-    } else if (field_strings[i] == '\r' || field_strings[i] == '\n') {
-      field_strings[i] = 0;
+      strings[i] = 0;
+      offsets[num_fields] = i + 1;
+    } else if (strings[i] == '*') {
+      checksum = buffer + i;
+      strings[i] = 0;
+      break;
+    } else if (strings[i] == '\r' || strings[i] == '\n') {
+      strings[i] = 0;
       break;
     }
   }
@@ -62,31 +91,68 @@ bool SentenceParser::parse(const char* buffer) {
     num_fields++;
   }
 
-  bool result = parse_fields(field_strings, field_offsets, num_fields);
-  if (result) {
-    rx_count_++;
-    this->emit(true);
+  checksum_valid = false;
+  if (checksum != nullptr) {
+    int expected;
+    if (sscanf(checksum + 1, "%2x", &expected) == 1) {
+      checksum_valid = CalculateChecksum(buffer) == expected;
+    }
   }
-  return result;
+  return true;
+}
+
+bool SentenceParser::parse(const char* buffer) {
+  SentenceFields fields;
+  if (!fields.split(buffer)) {
+    return false;
+  }
+  return parse(fields);
+}
+
+bool SentenceParser::accepts(const SentenceFields& fields) {
+  return discriminator().matches(fields);
 }
 
-bool SentenceParser::validate_checksum(const char* buffer) {
-  // Find the checksum field, delimited by a '*'
-  char* checksum_str = strchr(buffer, '*');
-  if (checksum_str == nullptr) {
+bool SentenceParser::check_checksum(const SentenceFields& fields) const {
+  if (!ignore_checksum_ && !fields.checksum_valid) {
+    ESP_LOGW("SensESP/NMEA0183", "Invalid checksum in sentence: %s",
+             fields.sentence);
     return false;
   }
-  // Read the checksum value
-  int checksum;
-  int result = sscanf(checksum_str + 1, "%2x", &checksum);
-  if (result != 1) {
+  return true;
+}
+
+void SentenceParser::received() {
+  rx_count_++;
+  this->emit(true);
+}
+
+bool SentenceParser::parse(const SentenceFields& fields) {
+  if (!check_checksum(fields)) {
     return false;
   }
-  // Calculate the checksum. The checksum is the XOR of all bytes between '$'
-  // and '*'.
-  int chksum = CalculateChecksum(buffer);
 
-  return chksum == checksum;
+  const char* field_strings = fields.strings;
+  const int* field_offsets = fields.offsets;
+  int num_fields = fields.num_fields;
+
+  bool result;
+  if (batching_) {
+    SentenceBatch batch;
+    batch.begin();
+    result = parse_fields(field_strings, field_offsets, num_fields);
+    if (result) {
+      batch.publish();
+    } else {
+      batch.discard();
+    }
+  } else {
+    result = parse_fields(field_strings, field_offsets, num_fields);
+  }
+  if (result) {
+    received();
+  }
+  return result;
 }
 
 }  // namespace sensesp::nmea0183
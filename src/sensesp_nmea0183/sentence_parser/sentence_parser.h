@@ -4,25 +4,93 @@
 #include <map>
 
 #include "sensesp_nmea0183/nmea0183.h"
+#include "sentence_fields.h"
+#include "sentence_output.h"
 
 namespace sensesp::nmea0183 {
 
 class NMEA0183Parser;
 
+/**
+ * @brief A field value that selects one of the parsers sharing an address.
+ *
+ * For example, MWV sentences carry apparent wind if field 2 is "R" and true
+ * wind if it is "T". A null value matches any sentence.
+ */
+struct SentenceDiscriminator {
+  int field = 0;
+  const char* value = nullptr;
+
+  bool matches(const SentenceFields& fields) const {
+    return value == nullptr ||
+           (field < fields.num_fields && strcmp(fields.field(field), value) == 0);
+  }
+};
+
 /**
  * @brief NMEA 0183 sentence parser base class.
  *
  * This class is responsible for parsing NMEA 0183 sentences. When a sentence
  * is successfully received, a boolean true value is emitted.
  *
+ * In batching mode, the outputs set by parse_fields are published together
+ * once the whole sentence has been parsed, and not at all if parsing fails.
+ * An observer of the parser itself, or of a SentenceCoalescer watching
+ * several of its outputs, then runs once per sentence and sees all outputs
+ * of that sentence updated.
+ *
+ * A lazy parser only sets the outputs that are observed, and is left out
+ * of dispatch and of the address filter of its NMEA0183Parser altogether
+ * if neither it nor any of its outputs is. The parser itself counts as
+ * observed if anything is attached to it, since its observers may read any
+ * output with get(); such outputs have to be marked with
+ * SentenceOutputBase::set_observed(). The GGA and RMC parsers also skip
+ * converting the fields of unobserved outputs; the other parsers convert
+ * every field and drop the values that aren't wanted.
  */
 class SentenceParser : public ValueProducer<bool> {
  public:
+  /// Register with nmea. A parser owned by an NMEA0183StaticParser is
+  /// constructed with a null nmea and not registered anywhere.
   SentenceParser(NMEA0183Parser* nmea);
   void ignore_checksum(bool ignore) { ignore_checksum_ = ignore; }
+  void set_batching(bool batching) { batching_ = batching; }
+  void set_lazy(bool lazy);
+  bool is_lazy() const { return lazy_; }
+
+  void attach(std::function<void()> observer) {
+    set_observed();
+    ValueProducer<bool>::attach(observer);
+  }
+  template <typename VConsumer>
+  auto connect_to(VConsumer&& consumer) {
+    set_observed();
+    return ValueProducer<bool>::connect_to(std::forward<VConsumer>(consumer));
+  }
+
+  /// True if sentences have to be dispatched to this parser: it is not lazy,
+  /// it is observed, or it hasn't declared its outputs
+  bool wanted() const { return !lazy_ || observed_ || !outputs_declared_; }
 
   virtual const char* sentence_address() = 0;
+  /// The field value this parser requires, if other parsers register the
+  /// same address. The dispatcher skips the parser for other values.
+  virtual SentenceDiscriminator discriminator() { return {}; }
+
   bool parse(const char* buffer);
+  /// Parse a sentence already split into fields
+  bool parse(const SentenceFields& fields);
+  /// True if the sentence matches the discriminator
+  bool accepts(const SentenceFields& fields);
+
+  /**
+   * @brief Parse a sentence with ParserT::parse_fields, called non-virtually.
+   *
+   * ParserT must be the dynamic type of this parser. Used by
+   * NMEA0183StaticParser, which knows the types of its parsers.
+   */
+  template <typename ParserT>
+  bool parse_as(const SentenceFields& fields);
 
   int get_rx_count() const { return rx_count_; }
 
@@ -38,13 +106,62 @@ class SentenceParser : public ValueProducer<bool> {
    */
   virtual bool parse_fields(const char* field_strings,
                             const int field_offsets[], int num_fields) = 0;
-  bool validate_checksum(const char* buffer);
+
+  /// Declare the outputs of the parser, so that it knows when they are
+  /// observed. Called from the constructors of the subclasses.
+  void declare_outputs(std::initializer_list<SentenceOutputBase*> outputs);
+
+  /// False, with a warning, if the checksum is required and invalid
+  bool check_checksum(const SentenceFields& fields) const;
+  /// Count and announce a successfully parsed sentence
+  void received();
 
  private:
+  /// Mark the parser as observed and have nmea_ rebuild its address filter
+  void set_observed();
+  /// Tell nmea_ that wanted() may have changed
+  void wanted_changed();
+
+  // The NMEA0183Parser this parser is registered with, or nullptr
+  NMEA0183Parser* nmea_;
   bool ignore_checksum_;
+  bool batching_ = false;
+  bool lazy_ = false;
+  // True if the parser or one of its declared outputs is observed
+  bool observed_ = false;
+  bool outputs_declared_ = false;
   int rx_count_ = 0;  // Number of sentences successfully received
+
+  friend class SentenceOutputBase;
 };
 
+template <typename ParserT>
+bool SentenceParser::parse_as(const SentenceFields& fields) {
+  if (!check_checksum(fields)) {
+    return false;
+  }
+  ParserT* parser = static_cast<ParserT*>(this);
+  bool result;
+  if (batching_) {
+    SentenceBatch batch;
+    batch.begin();
+    result = parser->ParserT::parse_fields(fields.strings, fields.offsets,
+                                           fields.num_fields);
+    if (result) {
+      batch.publish();
+    } else {
+      batch.discard();
+    }
+  } else {
+    result = parser->ParserT::parse_fields(fields.strings, fields.offsets,
+                                           fields.num_fields);
+  }
+  if (result) {
+    received();
+  }
+  return result;
+}
+
 }  // namespace sensesp
 
 #endif  // SENSESP_NMEA0183_SENTENCE_PARSER_H_
@@ -12,8 +12,8 @@ bool RMBSentenceParser::parse_fields(const char* field_strings,
   bool is_valid;
   float xte;
   char steer_dir;
-  String origin_wp;
-  String dest_wp;
+  WaypointID origin_wp;
+  WaypointID dest_wp;
   double dest_lat;
   double dest_lon;
   float range_nm;
@@ -183,7 +183,7 @@ bool BWCSentenceParser::parse_fields(const char* field_strings,
   float bearing_true;
   float bearing_mag;
   float distance_nm;
-  String waypoint_id;
+  WaypointID waypoint_id;
   char t_char;
   char m_char;
   char n_char;
@@ -261,7 +261,7 @@ bool WPLSentenceParser::parse_fields(const char* field_strings,
 
   double lat;
   double lon;
-  String waypoint_id;
+  WaypointID waypoint_id;
 
   // $xxWPL,lat,N/S,lon,E/W,waypoint_id*cs
   // eg. $GPWPL,4917.16,N,12310.64,W,003*65
@@ -309,7 +309,7 @@ bool RTESentenceParser::parse_fields(const char* field_strings,
   int num_sentences;
   int sentence_number;
   char route_type;
-  String route_id;
+  WaypointID route_id;
 
   // $xxRTE,num_sentences,sentence_number,c/w,route_id,wp1,wp2,...*cs
   // eg. $GPRTE,2,1,c,0,PBRCPK,## first sentence
@@ -324,30 +324,42 @@ bool RTESentenceParser::parse_fields(const char* field_strings,
   ok &= FLDP(Char, &route_type, 255)(field_strings + field_offsets[3]);
   ok &= FLDP(String, &route_id)(field_strings + field_offsets[4]);
 
+  // Waypoint IDs that don't fit are rejected before anything is collected
+  for (int i = 5; i < num_fields; i++) {
+    ok &= strlen(field_strings + field_offsets[i]) <= kMaxWaypointIDLength;
+  }
+
   if (!ok) {
     return false;
   }
 
-  // If this is the first sentence, reset the accumulator
-  if (sentence_number == 1) {
-    accumulated_waypoints_.clear();
-    total_sentences_ = num_sentences;
+  auto* assembly = assembler_.accept(route_id, num_sentences, sentence_number,
+                                     millis());
+  if (assembly == nullptr) {
+    // Out of sequence; the assembler counts it
+    return true;
   }
 
   // Accumulate waypoint IDs from remaining fields
   for (int i = 5; i < num_fields; i++) {
-    String wp_id;
-    if (FLDP_OPT(String, &wp_id)(field_strings + field_offsets[i])) {
-      if (wp_id.length() > 0) {
-        accumulated_waypoints_.push_back(wp_id);
-      }
+    const char* wp_id = field_strings + field_offsets[i];
+    if (wp_id[0] != 0 && !assembler_.add(assembly, WaypointID(wp_id))) {
+      ESP_LOGW("SensESP/NMEA0183", "Too many waypoints in RTE route");
+      break;
     }
   }
 
-  // Emit when the last sentence in the cycle is received
-  if (sentence_number == total_sentences_) {
+  // Emit when the last sentence of the route is received
+  if (assembly->complete()) {
+    if (waypoints_.wanted()) {
+      route_waypoints_.size = assembly->size;
+      for (size_t i = 0; i < assembly->size; i++) {
+        route_waypoints_.ids[i] = assembly->items[i];
+      }
+    }
+    assembler_.release(assembly);
     route_id_.set(route_id);
-    waypoints_.set(accumulated_waypoints_);
+    waypoints_.set(&route_waypoints_);
   }
 
   return true;
@@ -4,7 +4,9 @@
 #include "field_parsers.h"
 #include "sensesp/system/observablevalue.h"
 #include "sensesp/types/position.h"
+#include "sensesp_nmea0183/data/waypoint_data.h"
 #include "sensesp_nmea0183/nmea0183.h"
+#include "sentence_assembler.h"
 #include "sentence_parser.h"
 
 namespace sensesp::nmea0183 {
@@ -12,71 +14,104 @@ namespace sensesp::nmea0183 {
 /// Parser for RMB - Recommended Minimum Navigation Information
 class RMBSentenceParser : public SentenceParser {
  public:
-  RMBSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  RMBSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&cross_track_error_, &bearing_to_destination_,
+                     &range_to_destination_, &destination_closing_velocity_,
+                     &destination_waypoint_id_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..RMB"; }
 
-  ObservableValue<float> cross_track_error_;           // meters (signed)
-  ObservableValue<float> bearing_to_destination_;      // radians (true)
-  ObservableValue<float> range_to_destination_;        // meters
-  ObservableValue<float> destination_closing_velocity_; // m/s
-  ObservableValue<String> destination_waypoint_id_;
+  SentenceOutput<float> cross_track_error_;           // meters (signed)
+  SentenceOutput<float> bearing_to_destination_;      // radians (true)
+  SentenceOutput<float> range_to_destination_;        // meters
+  SentenceOutput<float> destination_closing_velocity_; // m/s
+  SentenceOutput<WaypointID> destination_waypoint_id_;
 };
 
 /// Parser for APB - Autopilot Sentence "B"
 class APBSentenceParser : public SentenceParser {
  public:
-  APBSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  APBSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&cross_track_error_, &heading_to_steer_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..APB"; }
 
-  ObservableValue<float> cross_track_error_;  // meters (signed)
-  ObservableValue<float> heading_to_steer_;   // radians (true)
+  SentenceOutput<float> cross_track_error_;  // meters (signed)
+  SentenceOutput<float> heading_to_steer_;   // radians (true)
 };
 
 /// Parser for BWC - Bearing and Distance to Waypoint (Great Circle)
 class BWCSentenceParser : public SentenceParser {
  public:
-  BWCSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  BWCSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&bearing_true_, &bearing_magnetic_, &distance_,
+                     &waypoint_id_, &waypoint_position_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..BWC"; }
 
-  ObservableValue<float> bearing_true_;      // radians
-  ObservableValue<float> bearing_magnetic_;  // radians
-  ObservableValue<float> distance_;          // meters
-  ObservableValue<String> waypoint_id_;
-  ObservableValue<Position> waypoint_position_;
+  SentenceOutput<float> bearing_true_;      // radians
+  SentenceOutput<float> bearing_magnetic_;  // radians
+  SentenceOutput<float> distance_;          // meters
+  SentenceOutput<WaypointID> waypoint_id_;
+  SentenceOutput<Position> waypoint_position_;
 };
 
 /// Parser for WPL - Waypoint Location
 class WPLSentenceParser : public SentenceParser {
  public:
-  WPLSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  WPLSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&position_, &waypoint_id_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..WPL"; }
 
-  ObservableValue<Position> position_;
-  ObservableValue<String> waypoint_id_;
+  SentenceOutput<Position> position_;
+  SentenceOutput<WaypointID> waypoint_id_;
 };
 
-/// Parser for RTE - Routes (multi-sentence)
+/// An RTE route not completed within this time is abandoned
+constexpr uint32_t kRTERouteTimeoutMs = 5000;
+
+/**
+ * @brief Parser for RTE - Routes (multi-sentence)
+ *
+ * The sentences of a route are reassembled with a SentenceAssembler keyed by
+ * route ID, and the route is emitted once all of them have arrived in order.
+ * waypoints_ points to the waypoint IDs of the last route, which the parser
+ * keeps until the next route is complete.
+ */
 class RTESentenceParser : public SentenceParser {
  public:
-  RTESentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  RTESentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&route_id_, &waypoints_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..RTE"; }
 
-  ObservableValue<String> route_id_;
-  ObservableValue<std::vector<String>> waypoints_;
+  /// Number of sentences ignored because they were out of sequence
+  unsigned int get_dropped_count() const {
+    return assembler_.get_dropped_count();
+  }
+  /// Number of routes abandoned because sentences were missing
+  unsigned int get_partial_count() const {
+    return assembler_.get_partial_count();
+  }
+
+  SentenceOutput<String> route_id_;
+  SentenceOutput<const RouteWaypoints*> waypoints_{&route_waypoints_};
 
  private:
-  int total_sentences_ = 0;
-  std::vector<String> accumulated_waypoints_;
+  RouteWaypoints route_waypoints_;
+  SentenceAssembler<WaypointID, WaypointID, kMaxRouteWaypoints> assembler_{
+      kRTERouteTimeoutMs};
 };
 
 }  // namespace sensesp::nmea0183
@@ -11,18 +11,22 @@ namespace sensesp::nmea0183 {
 /// Parser for MDA - Meteorological Composite
 class MDASentenceParser : public SentenceParser {
  public:
-  MDASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  MDASentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&barometric_pressure_, &air_temperature_,
+                     &water_temperature_, &relative_humidity_, &dew_point_,
+                     &true_wind_direction_, &true_wind_speed_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..MDA"; }
 
-  ObservableValue<float> barometric_pressure_;  // Pascals
-  ObservableValue<float> air_temperature_;      // Kelvin
-  ObservableValue<float> water_temperature_;    // Kelvin
-  ObservableValue<float> relative_humidity_;    // ratio (0-1)
-  ObservableValue<float> dew_point_;            // Kelvin
-  ObservableValue<float> true_wind_direction_;  // radians
-  ObservableValue<float> true_wind_speed_;      // m/s
+  SentenceOutput<float> barometric_pressure_;  // Pascals
+  SentenceOutput<float> air_temperature_;      // Kelvin
+  SentenceOutput<float> water_temperature_;    // Kelvin
+  SentenceOutput<float> relative_humidity_;    // ratio (0-1)
+  SentenceOutput<float> dew_point_;            // Kelvin
+  SentenceOutput<float> true_wind_direction_;  // radians
+  SentenceOutput<float> true_wind_speed_;      // m/s
 };
 
 }  // namespace sensesp::nmea0183
@@ -1,6 +1,7 @@
 #ifndef SENSEP_NMEA0183_WIND_SENTENCE_PARSER_H_
 #define SENSEP_NMEA0183_WIND_SENTENCE_PARSER_H_
 
+#include "deadband_value.h"
 #include "field_parsers.h"
 #include "sensesp_nmea0183/nmea0183.h"
 #include "sensesp/system/observablevalue.h"
@@ -12,50 +13,60 @@ namespace sensesp::nmea0183 {
 class MWVSentenceParser : public SentenceParser {
  public:
   MWVSentenceParser(NMEA0183Parser* nmea)
-      : SentenceParser(nmea) {}
+      : SentenceParser(nmea) {
+    declare_outputs({&apparent_wind_speed_, &apparent_wind_angle_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..MWV"; }
+  SentenceDiscriminator discriminator() override { return {2, "R"}; }
 
-  ObservableValue<float> apparent_wind_speed_;
-  ObservableValue<float> apparent_wind_angle_;
+  SentenceOutput<float> apparent_wind_speed_;
+  DeadbandValue apparent_wind_angle_{true};
 };
 
 /// Parser for MWV (Wind Speed and Angle) sentences — true wind (T reference)
 class TrueWindMWVSentenceParser : public SentenceParser {
  public:
   TrueWindMWVSentenceParser(NMEA0183Parser* nmea)
-      : SentenceParser(nmea) {}
+      : SentenceParser(nmea) {
+    declare_outputs({&true_wind_direction_, &true_wind_speed_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..MWV"; }
+  SentenceDiscriminator discriminator() override { return {2, "T"}; }
 
-  ObservableValue<float> true_wind_direction_;  // radians
-  ObservableValue<float> true_wind_speed_;      // m/s
+  SentenceOutput<float> true_wind_direction_;  // radians
+  SentenceOutput<float> true_wind_speed_;      // m/s
 };
 
 /// Parser for MWD (Wind Direction and Speed, True) sentences
 class MWDSentenceParser : public SentenceParser {
  public:
-  MWDSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  MWDSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&true_wind_direction_, &true_wind_speed_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..MWD"; }
 
-  ObservableValue<float> true_wind_direction_;  // radians
-  ObservableValue<float> true_wind_speed_;      // m/s
+  SentenceOutput<float> true_wind_direction_;  // radians
+  SentenceOutput<float> true_wind_speed_;      // m/s
 };
 
 /// Parser for VWR (Relative Wind Speed and Angle, deprecated) sentences
 class VWRSentenceParser : public SentenceParser {
  public:
-  VWRSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {}
+  VWRSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&apparent_wind_angle_, &apparent_wind_speed_});
+  }
   bool parse_fields(const char* field_strings, const int field_offsets[],
                     int num_fields) override final;
   const char* sentence_address() override { return "..VWR"; }
 
-  ObservableValue<float> apparent_wind_angle_;  // radians (signed: port < 0)
-  ObservableValue<float> apparent_wind_speed_;  // m/s
+  SentenceOutput<float> apparent_wind_angle_;  // radians (signed: port < 0)
+  SentenceOutput<float> apparent_wind_speed_;  // m/s
 };
 
 }  // namespace sensesp::nmea0183
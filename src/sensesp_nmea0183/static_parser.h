@@ -0,0 +1,133 @@
+#ifndef SENSESP_NMEA0183_STATIC_PARSER_H_
+#define SENSESP_NMEA0183_STATIC_PARSER_H_
+
+#include <string.h>
+
+#include <tuple>
+#include <utility>
+
+#include "sensesp_nmea0183/io/sentence_framer.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/sentence_parser.h"
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief NMEA 0183 parser with a sentence parser set fixed at compile time.
+ *
+ * An alternative to NMEA0183Parser for firmware that knows all the sentences
+ * it reads, for example:
+ *
+ *   auto* nmea = new NMEA0183StaticParser<GGASentenceParser,
+ *                                         RMCSentenceParser>();
+ *   new NMEA0183IO(&Serial1, nmea->framer());
+ *   nmea->get<GGASentenceParser>().position_.connect_to(...);
+ *
+ * The parsers are members of this object, constructed without an
+ * NMEA0183Parser, so registering them takes no heap. Dispatch is unrolled
+ * over the parser types in order: the address, discriminator and
+ * parse_fields of each parser are called non-virtually and can be inlined.
+ * As with NMEA0183Parser, a sentence goes to the first parser that parses it
+ * successfully.
+ *
+ * The Connect* functions of wiring.h create their own parsers and can't be
+ * used with this class; connect the parser outputs directly.
+ */
+template <typename... Parsers>
+class NMEA0183StaticParser {
+ public:
+  NMEA0183StaticParser() : parsers_{kNoParser<Parsers>...} {}
+
+  /// The parser of type ParserT
+  template <typename ParserT>
+  ParserT& get() {
+    return std::get<ParserT>(parsers_);
+  }
+  /// The parser at index I of Parsers
+  template <size_t I>
+  auto& get() {
+    return std::get<I>(parsers_);
+  }
+
+  /// Parse a sentence without trailing whitespace
+  void parse(const char* sentence) {
+    // Check that the sentence starts with a dollar or an exclamation sign
+    if (sentence[0] != '$' && sentence[0] != '!') {
+      return;
+    }
+    const char* address = sentence + 1;
+    size_t length = strcspn(address, ",*");
+    if (address[length] != ',' || !accepts_address(address, length)) {
+      return;
+    }
+    SentenceFields fields;
+    if (!fields.split(sentence)) {
+      return;
+    }
+    dispatch(fields, address, length, kIndices);
+  }
+
+  /// True if a wanted parser handles sentences with this address field
+  bool accepts_address(const char* address, size_t length) {
+    return accepts_address(address, length, kIndices);
+  }
+
+  /// A framer that feeds this parser, for NMEA0183IO
+  SentenceFramer framer() {
+    return SentenceFramer(
+        [this](const char* sentence) { parse(sentence); },
+        [this](const char* address, size_t length) {
+          return accepts_address(address, length);
+        });
+  }
+
+ protected:
+  template <typename>
+  static constexpr NMEA0183Parser* kNoParser = nullptr;
+  static constexpr auto kIndices = std::index_sequence_for<Parsers...>{};
+
+  template <size_t I>
+  using ParserType = std::tuple_element_t<I, std::tuple<Parsers...>>;
+
+  template <size_t I>
+  bool matches_address(const char* address, size_t length) {
+    using ParserT = ParserType<I>;
+    return AddressMatches(address, length,
+                          std::get<I>(parsers_).ParserT::sentence_address());
+  }
+
+  template <size_t I>
+  bool try_parse(const SentenceFields& fields, const char* address,
+                 size_t length) {
+    using ParserT = ParserType<I>;
+    ParserT& parser = std::get<I>(parsers_);
+    if (!parser.wanted() || !matches_address<I>(address, length) ||
+        !parser.ParserT::discriminator().matches(fields)) {
+      return false;
+    }
+    bool result = parser.template parse_as<ParserT>(fields);
+    ESP_LOGV("SensESP/NMEA0183", "Parsed sentence %s with result %s",
+             fields.sentence, result ? "true" : "false");
+    return result;
+  }
+
+  template <size_t... I>
+  bool accepts_address(const char* address, size_t length,
+                       std::index_sequence<I...>) {
+    return ((std::get<I>(parsers_).wanted() &&
+             matches_address<I>(address, length)) ||
+            ...);
+  }
+
+  template <size_t... I>
+  void dispatch(const SentenceFields& fields, const char* address,
+                size_t length, std::index_sequence<I...>) {
+    (try_parse<I>(fields, address, length) || ...);
+  }
+
+  std::tuple<Parsers...> parsers_;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_STATIC_PARSER_H_
@@ -0,0 +1,200 @@
+#include "gnss_epoch_assembler.h"
+
+#include <math.h>
+
+#include "sensesp.h"
+
+namespace sensesp::nmea0183 {
+
+/// Times of fix are parsed from the same hhmmss.ss text, so a small
+/// tolerance is enough to compare them.
+static bool SameTime(float a, float b) {
+  return a != kInvalidFloat && b != kInvalidFloat && fabsf(a - b) < 0.005;
+}
+
+/// Copy the valid fields of src over dst.
+static void MergeFix(GNSSFix* dst, const GNSSFix& src) {
+  if (src.position.latitude != kInvalidDouble &&
+      src.position.longitude != kInvalidDouble) {
+    dst->position.latitude = src.position.latitude;
+    dst->position.longitude = src.position.longitude;
+    // RMC and GLL do not report altitude; keep the one from GGA
+    if (src.position.altitude != kInvalidFloat &&
+        src.position.altitude != kPositionInvalidAltitude) {
+      dst->position.altitude = src.position.altitude;
+    }
+  }
+  if (src.datetime != -1) dst->datetime = src.datetime;
+  if (src.quality != kInvalidInt) dst->quality = src.quality;
+  if (src.num_satellites != kInvalidInt) {
+    dst->num_satellites = src.num_satellites;
+  }
+  if (src.fix_type != kInvalidInt) dst->fix_type = src.fix_type;
+  if (src.horizontal_dilution != kInvalidFloat) {
+    dst->horizontal_dilution = src.horizontal_dilution;
+  }
+  if (src.pdop != kInvalidFloat) dst->pdop = src.pdop;
+  if (src.vdop != kInvalidFloat) dst->vdop = src.vdop;
+  if (src.geoidal_separation != kInvalidFloat) {
+    dst->geoidal_separation = src.geoidal_separation;
+  }
+  if (src.dgps_age != kInvalidFloat) dst->dgps_age = src.dgps_age;
+  if (src.dgps_id != kInvalidInt) dst->dgps_id = src.dgps_id;
+  if (src.speed != kInvalidFloat) dst->speed = src.speed;
+  if (src.true_course != kInvalidFloat) dst->true_course = src.true_course;
+  if (src.variation != kInvalidFloat) dst->variation = src.variation;
+}
+
+GNSSEpochAssembler::GNSSEpochAssembler(
+    GGASentenceParser* gga, RMCSentenceParser* rmc, GLLSentenceParser* gll,
+    GSASentenceParser* gsa, VTGSentenceParser* vtg, ZDASentenceParser* zda,
+    unsigned int timeout_ms)
+    : ValueProducer<GNSSFix>(), timeout_ms_{timeout_ms} {
+  // The field outputs stage their values while a sentence is being parsed.
+  // The parser itself notifies once parse_fields has returned, and that is
+  // when the staged fields are committed to the epoch.
+
+  if (gga != nullptr) {
+    gga->position_.attach(
+        [this, gga]() { pending_.position = gga->position_.get(); });
+    gga->quality_.attach([this, gga]() { pending_.quality = gga->quality_.get(); });
+    gga->num_satellites_.attach([this, gga]() {
+      pending_.num_satellites = gga->num_satellites_.get();
+    });
+    gga->horizontal_dilution_.attach([this, gga]() {
+      pending_.horizontal_dilution = gga->horizontal_dilution_.get();
+    });
+    gga->geoidal_separation_.attach([this, gga]() {
+      pending_.geoidal_separation = gga->geoidal_separation_.get();
+    });
+    gga->dgps_age_.attach(
+        [this, gga]() { pending_.dgps_age = gga->dgps_age_.get(); });
+    gga->dgps_id_.attach(
+        [this, gga]() { pending_.dgps_id = gga->dgps_id_.get(); });
+    // Read from the parser observer only; keep it parsed by lazy parsers
+    gga->utc_time_.set_observed();
+    gga->attach([this, gga]() { commit(kGGA, gga->utc_time_.get()); });
+  }
+
+  if (rmc != nullptr) {
+    rmc->position_.attach([this, rmc]() {
+      pending_.position = rmc->position_.get();
+    });
+    rmc->datetime_.attach(
+        [this, rmc]() { pending_.datetime = rmc->datetime_.get(); });
+    rmc->speed_.attach([this, rmc]() { pending_.speed = rmc->speed_.get(); });
+    rmc->true_course_.attach(
+        [this, rmc]() { pending_.true_course = rmc->true_course_.get(); });
+    rmc->variation_.attach(
+        [this, rmc]() { pending_.variation = rmc->variation_.get(); });
+    // Read from the parser observer only; keep it parsed by lazy parsers
+    rmc->utc_time_.set_observed();
+    rmc->attach([this, rmc]() { commit(kRMC, rmc->utc_time_.get()); });
+  }
+
+  if (gll != nullptr) {
+    // GLL time is optional; stage it so that an absent one is not mistaken
+    // for the previous sentence's
+    gll->utc_time_.attach(
+        [this, gll]() { pending_.utc_time = gll->utc_time_.get(); });
+    gll->position_.attach([this, gll]() {
+      pending_.position = gll->position_.get();
+    });
+    gll->attach([this]() { commit(kGLL, pending_.utc_time); });
+  }
+
+  if (gsa != nullptr) {
+    gsa->fix_type_.attach(
+        [this, gsa]() { pending_.fix_type = gsa->fix_type_.get(); });
+    gsa->pdop_.attach([this, gsa]() { pending_.pdop = gsa->pdop_.get(); });
+    gsa->hdop_.attach([this, gsa]() {
+      pending_.horizontal_dilution = gsa->hdop_.get();
+    });
+    gsa->vdop_.attach([this, gsa]() { pending_.vdop = gsa->vdop_.get(); });
+    gsa->attach([this]() { commit(kGSA, kInvalidFloat); });
+  }
+
+  if (vtg != nullptr) {
+    vtg->true_course_.attach(
+        [this, vtg]() { pending_.true_course = vtg->true_course_.get(); });
+    vtg->speed_.attach([this, vtg]() { pending_.speed = vtg->speed_.get(); });
+    vtg->attach([this]() { commit(kVTG, kInvalidFloat); });
+  }
+
+  if (zda != nullptr) {
+    zda->datetime_.attach(
+        [this, zda]() { pending_.datetime = zda->datetime_.get(); });
+    // Read from the parser observer only; keep it parsed by lazy parsers
+    zda->utc_time_.set_observed();
+    zda->attach([this, zda]() { commit(kZDA, zda->utc_time_.get()); });
+  }
+}
+
+GNSSEpochAssembler::~GNSSEpochAssembler() { cancel_timeout(); }
+
+void GNSSEpochAssembler::commit(uint8_t source, float utc_time) {
+  GNSSFix staged = pending_;
+  pending_ = GNSSFix();
+
+  if (utc_time == kInvalidFloat) {
+    if (!epoch_open_) {
+      // Part of the epoch just emitted or of the next one
+      MergeFix(&carry_, staged);
+      return;
+    }
+  } else {
+    bool in_open_epoch = epoch_open_ && SameTime(epoch_.utc_time, utc_time);
+    if (!in_open_epoch && SameTime(utc_time, last_emitted_time_) &&
+        (last_emitted_sources_ & source) == 0) {
+      // A straggler of the epoch that was already emitted. Wait for this
+      // sentence from now on.
+      expected_sources_ |= source;
+      late_count_++;
+      return;
+    }
+    if (epoch_open_ && epoch_.utc_time != kInvalidFloat && !in_open_epoch) {
+      complete_epoch();
+    }
+    if (!epoch_open_) {
+      open_epoch(utc_time);
+    }
+  }
+
+  MergeFix(&epoch_, staged);
+  epoch_.sources |= source;
+
+  if (expected_sources_ != 0 &&
+      (epoch_.sources & expected_sources_) == expected_sources_) {
+    complete_epoch();
+  }
+}
+
+void GNSSEpochAssembler::open_epoch(float utc_time) {
+  epoch_ = carry_;
+  epoch_.utc_time = utc_time;
+  carry_ = GNSSFix();
+  epoch_open_ = true;
+  timeout_event_ = event_loop()->onDelay(timeout_ms_, [this]() {
+    // The event loop frees the event once it has run
+    timeout_event_ = nullptr;
+    complete_epoch();
+  });
+}
+
+void GNSSEpochAssembler::cancel_timeout() {
+  if (timeout_event_ != nullptr) {
+    event_loop()->remove(timeout_event_);
+    timeout_event_ = nullptr;
+  }
+}
+
+void GNSSEpochAssembler::complete_epoch() {
+  cancel_timeout();
+  epoch_open_ = false;
+  last_emitted_time_ = epoch_.utc_time;
+  last_emitted_sources_ = epoch_.sources;
+  expected_sources_ = epoch_.sources;
+  this->emit(epoch_);
+}
+
+}  // namespace sensesp::nmea0183
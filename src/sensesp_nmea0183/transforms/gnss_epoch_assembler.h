@@ -0,0 +1,80 @@
+#ifndef SENSESP_NMEA0183_GNSS_EPOCH_ASSEMBLER_H_
+#define SENSESP_NMEA0183_GNSS_EPOCH_ASSEMBLER_H_
+
+#include "sensesp.h"
+#include "sensesp/system/valueproducer.h"
+#include "sensesp_nmea0183/data/gnss_data.h"
+#include "sensesp_nmea0183/sentence_parser/gnss_sentence_parser.h"
+
+namespace sensesp::nmea0183 {
+
+/// Default time to wait for the remaining sentences of an epoch, in ms.
+constexpr unsigned int kGNSSEpochTimeout = 200;
+
+/**
+ * @brief Merge GGA, RMC, GLL, GSA, VTG and ZDA output of one fix into a
+ * single GNSSFix.
+ *
+ * A receiver reports each fix (epoch) in several sentences. The sentences
+ * carrying a UTC time of fix (GGA, RMC, GLL, ZDA) are keyed on it; GSA and VTG
+ * carry no time and are merged into the epoch that is open when they arrive.
+ * A time-less sentence arriving while no epoch is open, such as the second
+ * GSA of a multi-constellation receiver, never opens one and doesn't count
+ * towards the sentences of an epoch. Its fields are carried into the next
+ * epoch, where the sentences of that epoch override them.
+ *
+ * The assembler learns which sentences make up an epoch from the previous
+ * one and emits the fix as soon as all of them have arrived. Until then, or
+ * if the receiver's output changes, an epoch is emitted when a sentence with
+ * a new time of fix arrives or when the timeout expires. A sentence arriving
+ * late for an already emitted epoch is dropped and the assembler waits for
+ * it in the following epochs.
+ *
+ * Any of the parsers may be nullptr.
+ */
+class GNSSEpochAssembler : public ValueProducer<GNSSFix> {
+ public:
+  // Source bits in GNSSFix::sources
+  static constexpr uint8_t kGGA = 1 << 0;
+  static constexpr uint8_t kRMC = 1 << 1;
+  static constexpr uint8_t kGLL = 1 << 2;
+  static constexpr uint8_t kGSA = 1 << 3;
+  static constexpr uint8_t kVTG = 1 << 4;
+  static constexpr uint8_t kZDA = 1 << 5;
+
+  GNSSEpochAssembler(GGASentenceParser* gga, RMCSentenceParser* rmc,
+                     GLLSentenceParser* gll, GSASentenceParser* gsa,
+                     VTGSentenceParser* vtg, ZDASentenceParser* zda,
+                     unsigned int timeout_ms = kGNSSEpochTimeout);
+  ~GNSSEpochAssembler();
+
+  /// Sentence sources expected to complete an epoch
+  uint8_t get_expected_sources() const { return expected_sources_; }
+  /// Number of late sentences dropped because their epoch was already emitted
+  int get_late_count() const { return late_count_; }
+
+ protected:
+  void commit(uint8_t source, float utc_time);
+  void open_epoch(float utc_time);
+  void complete_epoch();
+  void cancel_timeout();
+
+  unsigned int timeout_ms_;
+  // Fields staged by the sentence being parsed
+  GNSSFix pending_;
+  // The epoch being assembled
+  GNSSFix epoch_;
+  bool epoch_open_ = false;
+  // Fields of time-less sentences received while no epoch was open
+  GNSSFix carry_;
+  // Timeout of the open epoch
+  reactesp::Event* timeout_event_ = nullptr;
+  float last_emitted_time_ = kInvalidFloat;
+  uint8_t last_emitted_sources_ = 0;
+  uint8_t expected_sources_ = 0;
+  int late_count_ = 0;
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_GNSS_EPOCH_ASSEMBLER_H_
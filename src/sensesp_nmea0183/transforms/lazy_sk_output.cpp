@@ -0,0 +1,32 @@
+#include "lazy_sk_output.h"
+
+namespace sensesp::nmea0183 {
+
+LazySKOutputBase::LazySKOutputBase() : next_{first_} { first_ = this; }
+
+LazySKOutputBase::~LazySKOutputBase() {
+  for (LazySKOutputBase** p = &first_; *p != nullptr; p = &(*p)->next_) {
+    if (*p == this) {
+      *p = next_;
+      return;
+    }
+  }
+}
+
+void LazySKOutputBase::materialize_all() {
+  for (LazySKOutputBase* p = first_; p != nullptr; p = p->next_) {
+    p->materialize();
+  }
+}
+
+unsigned int LazySKOutputBase::get_pending_count() {
+  unsigned int count = 0;
+  for (LazySKOutputBase* p = first_; p != nullptr; p = p->next_) {
+    if (!p->materialized_) {
+      count++;
+    }
+  }
+  return count;
+}
+
+}  // namespace sensesp::nmea0183
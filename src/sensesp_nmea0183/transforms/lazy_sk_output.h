@@ -0,0 +1,132 @@
+#ifndef SENSESP_NMEA0183_LAZY_SK_OUTPUT_H_
+#define SENSESP_NMEA0183_LAZY_SK_OUTPUT_H_
+
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/signalk/signalk_time.h"
+#include "sensesp/system/valueconsumer.h"
+#include "sensesp/system/valueproducer.h"
+#include "sensesp_nmea0183/boot_report.h"
+#include "sensesp_nmea0183/wiring_arena.h"
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Type independent part of LazySKOutput.
+ *
+ * Pending outputs are kept in an intrusive list, so that all of them can be
+ * created at once, e.g. before the configuration UI is served.
+ */
+class LazySKOutputBase {
+ public:
+  LazySKOutputBase();
+  virtual ~LazySKOutputBase();
+
+  /// Create the Signal K output if it hasn't been created yet
+  virtual void materialize() = 0;
+  bool is_materialized() const { return materialized_; }
+
+  /**
+   * @brief Defer the creation of outputs constructed from now on.
+   *
+   * Off by default: a LazySKOutput then creates its output right away, as
+   * an SKOutput created directly would.
+   */
+  static void set_lazy(bool lazy) { lazy_ = lazy; }
+  static bool is_lazy() { return lazy_; }
+  /// Create the outputs of all pending LazySKOutputs
+  static void materialize_all();
+  /// Number of LazySKOutputs whose output hasn't been created
+  static unsigned int get_pending_count();
+
+ protected:
+  static inline bool lazy_ = false;
+  static inline LazySKOutputBase* first_ = nullptr;
+  static inline bool first_value_reported_ = false;
+
+  bool materialized_ = false;
+  LazySKOutputBase* next_ = nullptr;
+};
+
+/**
+ * @brief SKOutput created on the first value.
+ *
+ * Constructing an SKOutput registers it and loads its configuration, which
+ * at boot means a file read per output. When LazySKOutputBase::set_lazy() is
+ * on, a LazySKOutput only keeps the constructor arguments and creates the
+ * OutputT on the first set() or get_output() call. Outputs of data that
+ * never arrives are never created, and until their first value they don't
+ * appear in the configuration UI; materialize_all() creates them.
+ *
+ * Values are passed on to the output and emitted unchanged, so a
+ * LazySKOutput can be chained like the SKOutput it stands for.
+ *
+ * The output is created with WiringNew(). An output created after the
+ * wiring is allocated on the heap, even if the LazySKOutput itself was
+ * placed in a WiringArena.
+ */
+template <typename T, typename OutputT = SKOutput<T>>
+class LazySKOutput : public LazySKOutputBase,
+                     public ValueConsumer<T>,
+                     public ValueProducer<T> {
+ public:
+  LazySKOutput(const String& sk_path, const String& config_path = "",
+               SKMetadata* meta = nullptr)
+      : sk_path_{sk_path}, config_path_{config_path}, meta_{meta} {
+    if (!lazy_) {
+      materialize();
+    }
+  }
+
+  virtual void set(const T& value) override {
+    if (output_ == nullptr) {
+      materialize();
+    }
+    if (!first_value_reported_) {
+      BootReport::mark("First Signal K value");
+      first_value_reported_ = true;
+    }
+    output_->set(value);
+    this->emit(value);
+  }
+
+  /// The Signal K path, as configured once the output exists
+  String get_sk_path() const {
+    return output_ == nullptr ? sk_path_ : output_->get_sk_path();
+  }
+  /// The configuration path of the output
+  String get_config_path() const {
+    return output_ == nullptr ? config_path_ : output_->get_config_path();
+  }
+
+  /// The output, created if needed, e.g. to access its configuration
+  OutputT* get_output() {
+    materialize();
+    return output_;
+  }
+
+  void materialize() override {
+    if (output_ != nullptr) {
+      return;
+    }
+    BootPhase phase("Create Signal K outputs");
+    output_ = WiringNew<OutputT>(sk_path_, config_path_, meta_);
+    materialized_ = true;
+    // The output holds the path and configuration path now
+    sk_path_ = String();
+    config_path_ = String();
+  }
+
+ protected:
+  String sk_path_;
+  String config_path_;
+  SKMetadata* meta_;
+  OutputT* output_ = nullptr;
+};
+
+using LazySKOutputFloat = LazySKOutput<float, SKOutputFloat>;
+using LazySKOutputInt = LazySKOutput<int, SKOutputInt>;
+using LazySKOutputTime = LazySKOutput<time_t, SKOutputTime>;
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_LAZY_SK_OUTPUT_H_
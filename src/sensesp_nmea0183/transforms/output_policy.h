@@ -0,0 +1,394 @@
+#ifndef SENSESP_NMEA0183_OUTPUT_POLICY_H_
+#define SENSESP_NMEA0183_OUTPUT_POLICY_H_
+
+#include <map>
+
+#include "sensesp.h"
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp/transforms/transform.h"
+#include "sensesp/types/position.h"
+#include "sensesp_nmea0183/transforms/lazy_sk_output.h"
+#include "sensesp_nmea0183/wiring_arena.h"
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief How an OutputPolicyTransform forwards its input.
+ */
+enum class OutputPolicyMode {
+  /// Forward every value
+  passthrough = 0,
+  /// Forward a value only if the interval has passed since the previous one;
+  /// drop the rest
+  max_rate = 1,
+  /// Forward at most one value per interval; the latest value received
+  /// during the interval wins
+  decimate = 2,
+  /// Forward the mean of the values received during each interval. Types
+  /// that cannot be averaged forward the latest value, and the values of an
+  /// angular output are averaged as directions.
+  average = 3,
+};
+
+/**
+ * @brief Output policy of one Signal K path.
+ */
+struct OutputPolicy {
+  OutputPolicyMode mode = OutputPolicyMode::passthrough;
+  unsigned int interval_ms = 0;
+};
+
+/// Output policies keyed by Signal K path. The key "*" applies to all paths
+/// of a wiring helper that have no policy of their own.
+using OutputPolicies = std::map<String, OutputPolicy>;
+
+/// Look up the policy of sk_path. Returns false if none applies.
+inline bool FindOutputPolicy(const OutputPolicies& policies,
+                             const char* sk_path, OutputPolicy* policy) {
+  auto it = policies.find(sk_path);
+  if (it == policies.end()) {
+    it = policies.find("*");
+  }
+  if (it == policies.end()) {
+    return false;
+  }
+  *policy = it->second;
+  return true;
+}
+
+/**
+ * @brief Configuration path of the policy in front of an output.
+ *
+ * Keyed on the configuration path of the output rather than on its Signal K
+ * path, since several outputs may publish the same path. Empty, so not
+ * saved, if the output has no configuration path.
+ */
+inline String OutputPolicyConfigPath(const String& output_config_path) {
+  if (output_config_path.length() == 0) {
+    return String();
+  }
+  return output_config_path + "/Output Policy";
+}
+
+/**
+ * @brief Running mean for OutputPolicyMode::average.
+ *
+ * The generic version keeps the latest value; numeric types and Position are
+ * specialized below.
+ */
+template <typename T>
+class OutputAverage {
+ public:
+  /// Average as angles in radians, where supported
+  void set_angular(bool) {}
+  void reset() {}
+  void add(const T& value) { latest_ = value; }
+  T get() const { return latest_; }
+
+ private:
+  T latest_;
+};
+
+/**
+ * Angles are averaged as unit vectors, so that the mean of 350° and 10° is
+ * 0° and not 180°. The mean is in [0, 2π), or in (-π, π] if any of the
+ * values averaged was negative.
+ */
+template <>
+class OutputAverage<float> {
+ public:
+  void set_angular(bool angular) { angular_ = angular; }
+  void reset() { sum_ = sin_sum_ = cos_sum_ = 0, count_ = 0, signed_ = false; }
+  void add(const float& value) {
+    if (angular_) {
+      sin_sum_ += sin(value);
+      cos_sum_ += cos(value);
+      signed_ = signed_ || value < 0;
+    } else {
+      sum_ += value;
+    }
+    count_++;
+  }
+  float get() const {
+    if (!angular_) {
+      return sum_ / count_;
+    }
+    double mean = atan2(sin_sum_, cos_sum_);
+    if (!signed_ && mean < 0) {
+      mean += 2 * PI;
+    }
+    return mean;
+  }
+
+ private:
+  bool angular_ = false;
+  double sum_ = 0;
+  double sin_sum_ = 0;
+  double cos_sum_ = 0;
+  bool signed_ = false;
+  int count_ = 0;
+};
+
+template <>
+class OutputAverage<int> {
+ public:
+  void set_angular(bool) {}
+  void reset() { sum_ = 0, count_ = 0; }
+  void add(const int& value) { sum_ += value, count_++; }
+  int get() const { return (int)lround((double)sum_ / count_); }
+
+ private:
+  long long sum_ = 0;
+  int count_ = 0;
+};
+
+template <>
+class OutputAverage<Position> {
+ public:
+  void set_angular(bool) {}
+  void reset() { latitude_ = longitude_ = altitude_ = 0, count_ = 0; }
+  void add(const Position& value) {
+    latitude_ += value.latitude;
+    longitude_ += value.longitude;
+    // One missing altitude makes the mean altitude missing as well
+    if (value.altitude == kPositionInvalidAltitude ||
+        altitude_ == kPositionInvalidAltitude) {
+      altitude_ = kPositionInvalidAltitude;
+    } else {
+      altitude_ += value.altitude;
+    }
+    count_++;
+  }
+  Position get() const {
+    Position mean;
+    mean.latitude = latitude_ / count_;
+    mean.longitude = longitude_ / count_;
+    mean.altitude = altitude_ == kPositionInvalidAltitude
+                        ? kPositionInvalidAltitude
+                        : altitude_ / count_;
+    return mean;
+  }
+
+ private:
+  double latitude_ = 0;
+  double longitude_ = 0;
+  double altitude_ = 0;
+  int count_ = 0;
+};
+
+/**
+ * @brief Rate limiting, decimation or time-window averaging in front of an
+ * output.
+ *
+ * Inserted by the wiring helpers between a data container member and its
+ * Signal K output, so that local consumers of the container still get every
+ * update while the network gets a bounded rate. The policy can be changed at
+ * runtime with set_policy() or through the configuration. An angular
+ * transform averages its values as angles in radians.
+ */
+template <typename T>
+class OutputPolicyTransform : public SymmetricTransform<T> {
+ public:
+  OutputPolicyTransform(const OutputPolicy& policy = OutputPolicy(),
+                        const String& config_path = "", bool angular = false)
+      : SymmetricTransform<T>(config_path), policy_{policy} {
+    average_.set_angular(angular);
+    this->load();
+  }
+
+  ~OutputPolicyTransform() { cancel_flush(); }
+
+  void set_policy(const OutputPolicy& policy) {
+    policy_ = policy;
+    has_pending_ = false;
+    average_.reset();
+    cancel_flush();
+  }
+  const OutputPolicy& get_policy() const { return policy_; }
+
+  /// Number of input values not forwarded as such
+  unsigned int get_suppressed_count() const { return suppressed_count_; }
+
+  virtual void set(const T& new_value) override {
+    unsigned long now = millis();
+    switch (policy_.mode) {
+      case OutputPolicyMode::passthrough:
+        this->emit(new_value);
+        return;
+      case OutputPolicyMode::max_rate:
+        if (has_emitted_ && now - last_emit_ms_ < policy_.interval_ms) {
+          suppressed_count_++;
+          return;
+        }
+        emit_now(new_value, now);
+        return;
+      case OutputPolicyMode::decimate:
+        if (!has_emitted_ || now - last_emit_ms_ >= policy_.interval_ms) {
+          has_pending_ = false;
+          emit_now(new_value, now);
+          return;
+        }
+        if (has_pending_) {
+          suppressed_count_++;
+        }
+        pending_ = new_value;
+        if (!has_pending_) {
+          has_pending_ = true;
+          schedule_flush(policy_.interval_ms - (now - last_emit_ms_));
+        }
+        return;
+      case OutputPolicyMode::average:
+        if (!has_pending_) {
+          has_pending_ = true;
+          average_.reset();
+          schedule_flush(policy_.interval_ms);
+        } else {
+          suppressed_count_++;
+        }
+        average_.add(new_value);
+        return;
+    }
+  }
+
+  virtual bool to_json(JsonObject& root) override {
+    root["mode"] = static_cast<int>(policy_.mode);
+    root["interval"] = policy_.interval_ms;
+    return true;
+  }
+
+  virtual bool from_json(const JsonObject& config) override {
+    if (!config["mode"].is<int>() || !config["interval"].is<int>()) {
+      return false;
+    }
+    int mode = config["mode"].as<int>();
+    if (mode < static_cast<int>(OutputPolicyMode::passthrough) ||
+        mode > static_cast<int>(OutputPolicyMode::average)) {
+      ESP_LOGW("SensESP/NMEA0183", "Unknown output policy mode %d", mode);
+      return false;
+    }
+    OutputPolicy policy;
+    policy.mode = static_cast<OutputPolicyMode>(mode);
+    policy.interval_ms = config["interval"].as<unsigned int>();
+    set_policy(policy);
+    return true;
+  }
+
+ protected:
+  void emit_now(const T& value, unsigned long now) {
+    has_emitted_ = true;
+    last_emit_ms_ = now;
+    this->emit(value);
+  }
+
+  void schedule_flush(unsigned long delay_ms) {
+    cancel_flush();
+    flush_event_ = event_loop()->onDelay(delay_ms, [this]() {
+      // The event loop frees the event once it has run
+      flush_event_ = nullptr;
+      if (!has_pending_) {
+        return;
+      }
+      has_pending_ = false;
+      if (policy_.mode == OutputPolicyMode::average) {
+        emit_now(average_.get(), millis());
+      } else {
+        emit_now(pending_, millis());
+      }
+    });
+  }
+
+  void cancel_flush() {
+    if (flush_event_ != nullptr) {
+      event_loop()->remove(flush_event_);
+      flush_event_ = nullptr;
+    }
+  }
+
+  OutputPolicy policy_;
+  bool has_emitted_ = false;
+  unsigned long last_emit_ms_ = 0;
+  bool has_pending_ = false;
+  T pending_;
+  OutputAverage<T> average_;
+  // Emits the pending value at the end of the interval
+  reactesp::Event* flush_event_ = nullptr;
+  unsigned int suppressed_count_ = 0;
+};
+
+template <typename T>
+const String ConfigSchema(const OutputPolicyTransform<T>& obj) {
+  return R"###({"type":"object","properties":{"mode":{"title":"Mode","type":"integer","description":"0 = every value, 1 = maximum rate, 2 = latest value per interval, 3 = mean per interval"},"interval":{"title":"Interval","type":"integer","description":"Output interval in milliseconds"}}})###";
+}
+
+/**
+ * @brief Insert the output policy configured for sk_path after producer.
+ *
+ * @param output_config_path Configuration path of the output the policy
+ * will feed, under which the policy is saved.
+ * @param angular True if the values are angles in radians, to be averaged
+ * as directions.
+ * @return The producer to connect the output to: a new OutputPolicyTransform
+ * if a policy applies to the path, producer itself otherwise.
+ */
+template <typename T>
+ValueProducer<T>* ApplyOutputPolicy(ValueProducer<T>* producer,
+                                    const OutputPolicies& policies,
+                                    const char* sk_path,
+                                    const String& output_config_path,
+                                    bool angular = false) {
+  OutputPolicy policy;
+  if (!FindOutputPolicy(policies, sk_path, &policy)) {
+    return producer;
+  }
+  return producer->connect_to(WiringNew<OutputPolicyTransform<T>>(
+      policy, OutputPolicyConfigPath(output_config_path), angular));
+}
+
+/**
+ * @brief Put the output policy configured for sk_path in front of output.
+ *
+ * @param output_config_path Configuration path of output, under which the
+ * policy is saved.
+ * @param angular True if the values are angles in radians, to be averaged
+ * as directions.
+ * @return The consumer to connect to: a new OutputPolicyTransform feeding
+ * output if a policy applies to sk_path, output itself otherwise.
+ */
+template <typename T>
+ValueConsumer<T>* WithOutputPolicy(ValueConsumer<T>* output,
+                                   const String& sk_path,
+                                   const String& output_config_path,
+                                   const OutputPolicies& policies,
+                                   bool angular = false) {
+  OutputPolicy policy;
+  if (!FindOutputPolicy(policies, sk_path.c_str(), &policy)) {
+    return output;
+  }
+  auto* transform = WiringNew<OutputPolicyTransform<T>>(
+      policy, OutputPolicyConfigPath(output_config_path), angular);
+  transform->connect_to(output);
+  return transform;
+}
+
+/// Put the output policy configured for the path of output in front of it
+template <typename T>
+ValueConsumer<T>* WithOutputPolicy(SKOutput<T>* output,
+                                   const OutputPolicies& policies,
+                                   bool angular = false) {
+  return WithOutputPolicy<T>(output, output->get_sk_path(),
+                             output->get_config_path(), policies, angular);
+}
+
+/// Put the output policy configured for the path of output in front of it,
+/// without creating the output
+template <typename T, typename OutputT>
+ValueConsumer<T>* WithOutputPolicy(LazySKOutput<T, OutputT>* output,
+                                   const OutputPolicies& policies,
+                                   bool angular = false) {
+  return WithOutputPolicy<T>(output, output->get_sk_path(),
+                             output->get_config_path(), policies, angular);
+}
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_OUTPUT_POLICY_H_
@@ -0,0 +1,125 @@
+#include "satellite_delta.h"
+
+namespace sensesp::nmea0183 {
+
+static bool SameSatellite(const GNSSSatelliteTable& a, size_t i,
+                          const GNSSSatelliteTable& b, size_t j) {
+  return a.ids()[i] == b.ids()[j] && a.systems()[i] == b.systems()[j] &&
+         a.signal_ids()[i] == b.signal_ids()[j];
+}
+
+static bool SameValues(const GNSSSatelliteTable& a, size_t i,
+                       const GNSSSatelliteTable& b, size_t j) {
+  return a.elevations()[i] == b.elevations()[j] &&
+         a.azimuths()[i] == b.azimuths()[j] && a.snrs()[i] == b.snrs()[j];
+}
+
+/// Index of satellite i of a in b, or -1. Receivers report satellites in
+/// a stable order, so the same index is tried first.
+static int FindSatellite(const GNSSSatelliteTable& a, size_t i,
+                         const GNSSSatelliteTable& b) {
+  if (i < b.size() && SameSatellite(a, i, b, i)) {
+    return i;
+  }
+  for (size_t j = 0; j < b.size(); j++) {
+    if (SameSatellite(a, i, b, j)) {
+      return j;
+    }
+  }
+  return -1;
+}
+
+GNSSSatelliteDeltaTransform::GNSSSatelliteDeltaTransform(
+    unsigned int keyframe_interval, const String& config_path)
+    : Transform<const GNSSSatelliteTable*, const GNSSSatelliteDelta*>(
+          config_path),
+      keyframe_interval_{keyframe_interval},
+      cycles_since_keyframe_{keyframe_interval} {
+  this->output_ = &delta_;
+  this->load();
+}
+
+void GNSSSatelliteDeltaTransform::set(
+    const GNSSSatelliteTable* const& table) {
+  if (table == nullptr) {
+    return;
+  }
+  const GNSSSatelliteTable& satellites = *table;
+  delta_.satellites.clear();
+  delta_.removed.clear();
+
+  cycles_since_keyframe_++;
+  delta_.keyframe = cycles_since_keyframe_ >= keyframe_interval_;
+  if (delta_.keyframe) {
+    cycles_since_keyframe_ = 0;
+    delta_.satellites = satellites;
+  } else {
+    for (size_t i = 0; i < satellites.size(); i++) {
+      int j = FindSatellite(satellites, i, previous_);
+      if (j < 0 || !SameValues(satellites, i, previous_, j)) {
+        delta_.satellites.push_back(satellites[i]);
+      }
+    }
+    for (size_t j = 0; j < previous_.size(); j++) {
+      if (FindSatellite(previous_, j, satellites) < 0) {
+        delta_.removed.push_back(previous_[j]);
+      }
+    }
+  }
+
+  previous_ = satellites;
+  this->emit(&delta_);
+  if (delta_.keyframe) {
+    keyframe_.set(&previous_);
+  }
+}
+
+bool GNSSSatelliteDeltaTransform::to_json(JsonObject& root) {
+  root["keyframe_interval"] = keyframe_interval_;
+  return true;
+}
+
+bool GNSSSatelliteDeltaTransform::from_json(const JsonObject& config) {
+  if (!config["keyframe_interval"].is<int>()) {
+    return false;
+  }
+  keyframe_interval_ = config["keyframe_interval"].as<unsigned int>();
+  return true;
+}
+
+const String ConfigSchema(const GNSSSatelliteDeltaTransform&) {
+  return R"###({"type":"object","properties":{"keyframe_interval":{"title":"Keyframe Interval","type":"integer","description":"Number of GSV cycles between full satellite lists"}}})###";
+}
+
+bool convertToJson(const GNSSSatelliteDelta& value, JsonVariant& dst) {
+  JsonObject obj = dst.to<JsonObject>();
+  obj["keyframe"] = value.keyframe;
+  obj["satellites"] = value.satellites;
+  if (!value.keyframe) {
+    obj["removed"] = value.removed;
+  }
+  return true;
+}
+
+bool convertToJson(const GNSSSatelliteDelta* value, JsonVariant& dst) {
+  if (value == nullptr) {
+    dst.set(nullptr);
+    return true;
+  }
+  return convertToJson(*value, dst);
+}
+
+void WriteJson(const GNSSSatelliteDelta& value, JsonWriter& writer) {
+  writer.begin_object();
+  writer.key("keyframe");
+  writer.value(value.keyframe);
+  writer.key("satellites");
+  WriteJson(value.satellites, writer);
+  if (!value.keyframe) {
+    writer.key("removed");
+    WriteJson(value.removed, writer);
+  }
+  writer.end_object();
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,72 @@
+#ifndef SENSESP_NMEA0183_SATELLITE_DELTA_H_
+#define SENSESP_NMEA0183_SATELLITE_DELTA_H_
+
+#include "sensesp/system/observablevalue.h"
+#include "sensesp/transforms/transform.h"
+#include "sensesp_nmea0183/data/gnss_data.h"
+
+namespace sensesp::nmea0183 {
+
+/// Default number of GSV cycles between full keyframes
+constexpr unsigned int kGNSSSatelliteKeyframeInterval = 10;
+
+/**
+ * @brief Change in the satellites in view from one GSV cycle to the next.
+ */
+struct GNSSSatelliteDelta {
+  /// If true, satellites holds the whole cycle and removed is empty
+  bool keyframe = false;
+  /// Satellites added or changed since the previous cycle
+  GNSSSatelliteTable satellites;
+  /// Satellites no longer in view, with their last reported values
+  GNSSSatelliteTable removed;
+};
+
+bool convertToJson(const GNSSSatelliteDelta& value, JsonVariant& dst);
+bool convertToJson(const GNSSSatelliteDelta* value, JsonVariant& dst);
+void WriteJson(const GNSSSatelliteDelta& value, JsonWriter& writer);
+
+/**
+ * @brief Diff consecutive GSV cycles.
+ *
+ * A satellite is identified by system, PRN and signal; it has changed if
+ * its elevation, azimuth or SNR differ. Every keyframe_interval cycles, and
+ * on the first cycle, a keyframe with all satellites is emitted instead of a
+ * delta; keyframes are also set to keyframe_ for consumers that need the
+ * whole list.
+ *
+ * Both outputs point to tables owned by the transform: the delta is valid
+ * until the next cycle, and keyframe_ points to the latest whole list.
+ */
+class GNSSSatelliteDeltaTransform
+    : public Transform<const GNSSSatelliteTable*, const GNSSSatelliteDelta*> {
+ public:
+  GNSSSatelliteDeltaTransform(
+      unsigned int keyframe_interval = kGNSSSatelliteKeyframeInterval,
+      const String& config_path = "");
+
+  virtual void set(const GNSSSatelliteTable* const& satellites) override;
+
+  /// Force the next cycle to be a keyframe
+  void request_keyframe() { cycles_since_keyframe_ = keyframe_interval_; }
+
+  virtual bool to_json(JsonObject& root) override;
+  virtual bool from_json(const JsonObject& config) override;
+
+  /// The whole satellite table. Notified on keyframes only, but the table
+  /// pointed to follows every cycle.
+  ObservableValue<const GNSSSatelliteTable*> keyframe_{nullptr};
+
+ protected:
+  unsigned int keyframe_interval_;
+  unsigned int cycles_since_keyframe_;
+  // The latest cycle, compared with the next one
+  GNSSSatelliteTable previous_;
+  GNSSSatelliteDelta delta_;
+};
+
+const String ConfigSchema(const GNSSSatelliteDeltaTransform& obj);
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_SATELLITE_DELTA_H_
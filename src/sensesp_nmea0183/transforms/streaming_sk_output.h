@@ -0,0 +1,59 @@
+#ifndef SENSESP_NMEA0183_STREAMING_SK_OUTPUT_H_
+#define SENSESP_NMEA0183_STREAMING_SK_OUTPUT_H_
+
+#include "sensesp/signalk/signalk_output.h"
+#include "sensesp_nmea0183/data/json_writer.h"
+
+namespace sensesp::nmea0183 {
+
+/// Size of the scratch area StreamingSKOutputs write their JSON into
+constexpr size_t kStreamingSKScratchSize = 4096;
+
+/// Scratch area shared by all StreamingSKOutputs. Deltas are built one at a
+/// time, and the JsonDocument keeps its own copy of the JSON.
+inline char streaming_sk_scratch[kStreamingSKScratchSize];
+
+/**
+ * @brief SKOutput for large values that streams them as JSON.
+ *
+ * The value is written with WriteJson(const T&, JsonWriter&) and attached
+ * to the delta as serialized JSON, instead of being converted into a
+ * JsonDocument node by node. The JSON is written into a fixed scratch area
+ * shared by all streaming outputs. A value too large for it, such as a
+ * table of well over 40 satellites, is written again into a String that
+ * is freed as soon as the delta has been built, so no memory is kept
+ * between deltas.
+ */
+template <typename T>
+class StreamingSKOutput : public SKOutput<T> {
+ public:
+  using SKOutput<T>::SKOutput;
+
+  virtual void as_signalk_json(JsonDocument& doc) override {
+    doc["path"] = this->get_sk_path();
+    FixedPrint scratch(streaming_sk_scratch, kStreamingSKScratchSize);
+    JsonWriter writer(scratch);
+    WriteJson(this->output_, writer);
+    if (!scratch.overflowed()) {
+      doc["value"] = serialized(scratch.data(), scratch.length());
+      return;
+    }
+    StringPrint buffer;
+    buffer.reserve(scratch.get_needed());
+    JsonWriter large_writer(buffer);
+    WriteJson(this->output_, large_writer);
+    doc["value"] = serialized(buffer.c_str(), buffer.length());
+  }
+
+  /// JSON of the current value
+  String get_json() const {
+    StringPrint buffer;
+    JsonWriter writer(buffer);
+    WriteJson(this->output_, writer);
+    return buffer.str();
+  }
+};
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_STREAMING_SK_OUTPUT_H_
@@ -7,6 +7,7 @@
 #include "sensesp/transforms/angle_correction.h"
 #include "sensesp/transforms/lambda_transform.h"
 #include "sensesp/types/json.h"
+#include "sensesp_nmea0183/boot_report.h"
 #include "sensesp_nmea0183/data/gnss_data.h"
 #include "sensesp_nmea0183/data/wind_data.h"
 #include "sensesp_nmea0183/sentence_parser/gnss_sentence_parser.h"
@@ -14,97 +15,191 @@
 #include "sensesp_nmea0183/sentence_parser/waypoint_sentence_parser.h"
 #include "sensesp_nmea0183/sentence_parser/weather_sentence_parser.h"
 #include "sensesp_nmea0183/sentence_parser/wind_sentence_parser.h"
+#include "sensesp_nmea0183/transforms/gnss_epoch_assembler.h"
+#include "sensesp_nmea0183/transforms/satellite_delta.h"
+#include "sensesp_nmea0183/transforms/streaming_sk_output.h"
 
 namespace sensesp::nmea0183 {
 
-void ConnectGNSS(NMEA0183Parser* nmea_input, GNSSData* location_data) {
-  GGASentenceParser* gga_sentence_parser = new GGASentenceParser(nmea_input);
-
-  GLLSentenceParser* gll_sentence_parser = new GLLSentenceParser(nmea_input);
+/// Update the individual GNSSData members from an assembled fix.
+static void PublishFix(const GNSSFix& fix, GNSSData* location_data) {
+  if (fix.position.latitude != kInvalidDouble &&
+      fix.position.longitude != kInvalidDouble) {
+    location_data->position.set(fix.position);
+  }
+  if (fix.quality != kInvalidInt) {
+    location_data->rtk_quality.set(GNSSQualityString(fix.quality));
+  }
+  if (fix.num_satellites != kInvalidInt) {
+    location_data->num_satellites.set(fix.num_satellites);
+  }
+  if (fix.horizontal_dilution != kInvalidFloat) {
+    location_data->horizontal_dilution.set(fix.horizontal_dilution);
+  }
+  if (fix.geoidal_separation != kInvalidFloat) {
+    location_data->geoidal_separation.set(fix.geoidal_separation);
+  }
+  if (fix.dgps_age != kInvalidFloat) {
+    location_data->dgps_age.set(fix.dgps_age);
+  }
+  if (fix.dgps_id != kInvalidInt) {
+    location_data->dgps_id.set(fix.dgps_id);
+  }
+  if (fix.datetime != -1) {
+    location_data->datetime.set(fix.datetime);
+  }
+  if (fix.speed != kInvalidFloat) {
+    location_data->speed.set(fix.speed);
+  }
+  if (fix.true_course != kInvalidFloat) {
+    location_data->true_course.set(fix.true_course);
+  }
+  if (fix.variation != kInvalidFloat) {
+    location_data->variation.set(fix.variation);
+  }
+  if (fix.fix_type != kInvalidInt) {
+    location_data->fix_type.set(fix.fix_type);
+  }
+  if (fix.pdop != kInvalidFloat) {
+    location_data->pdop.set(fix.pdop);
+  }
+  if (fix.vdop != kInvalidFloat) {
+    location_data->vdop.set(fix.vdop);
+  }
+}
 
-  RMCSentenceParser* rmc_sentence_parser = new RMCSentenceParser(nmea_input);
+void ConnectGNSS(NMEA0183Parser* nmea_input, GNSSData* location_data,
+                 const OutputPolicies& output_policies,
+                 bool satellite_deltas) {
+  BootPhase boot_phase("ConnectGNSS");
+  auto* gga_sentence_parser = WiringNew<GGASentenceParser>(nmea_input);
 
-  VTGSentenceParser* vtg_sentence_parser = new VTGSentenceParser(nmea_input);
+  auto* gll_sentence_parser = WiringNew<GLLSentenceParser>(nmea_input);
 
-  GSVSentenceParser* gsv_sentence_parser = new GSVSentenceParser(nmea_input);
+  auto* rmc_sentence_parser = WiringNew<RMCSentenceParser>(nmea_input);
 
-  auto* gsa_sentence_parser = new GSASentenceParser(nmea_input);
+  auto* vtg_sentence_parser = WiringNew<VTGSentenceParser>(nmea_input);
 
-  auto* zda_sentence_parser = new ZDASentenceParser(nmea_input);
+  auto* gsv_sentence_parser = WiringNew<GSVSentenceParser>(nmea_input);
 
-  gga_sentence_parser->position_.connect_to(&location_data->position);
-  gga_sentence_parser->gnss_quality_.connect_to(&location_data->rtk_quality);
-  gga_sentence_parser->num_satellites_.connect_to(
-      &location_data->num_satellites);
-  gga_sentence_parser->horizontal_dilution_.connect_to(
-      &location_data->horizontal_dilution);
-  gga_sentence_parser->geoidal_separation_.connect_to(
-      &location_data->geoidal_separation);
-  gga_sentence_parser->dgps_age_.connect_to(&location_data->dgps_age);
-  gga_sentence_parser->dgps_id_.connect_to(&location_data->dgps_id);
+  auto* gsa_sentence_parser = WiringNew<GSASentenceParser>(nmea_input);
 
-  gll_sentence_parser->position_.connect_to(&location_data->position);
+  auto* zda_sentence_parser = WiringNew<ZDASentenceParser>(nmea_input);
 
-  rmc_sentence_parser->position_.connect_to(&location_data->position);
-  rmc_sentence_parser->datetime_.connect_to(&location_data->datetime);
-  rmc_sentence_parser->speed_.connect_to(&location_data->speed);
-  rmc_sentence_parser->variation_.connect_to(&location_data->variation);
+  // GGA, RMC, GLL, GSA, VTG and ZDA all report the same fix. Merge them into
+  // one GNSSFix per epoch so that each GNSSData member is updated once per
+  // fix and from a consistent set of sentences.
+  auto* epoch_assembler = WiringNew<GNSSEpochAssembler>(
+      gga_sentence_parser, rmc_sentence_parser, gll_sentence_parser,
+      gsa_sentence_parser, vtg_sentence_parser, zda_sentence_parser);
 
-  vtg_sentence_parser->true_course_.connect_to(&location_data->true_course);
+  epoch_assembler->connect_to(&location_data->fix);
+  location_data->fix.attach([location_data]() {
+    PublishFix(location_data->fix.get(), location_data);
+  });
 
   // num_satellites stays sourced from GGA (satellites used in the fix); GSV's
   // count is satellites in view, already carried by satellitesInView, and wiring
   // both here makes navigation.gnss.satellites flip between the two meanings.
   gsv_sentence_parser->satellites_.connect_to(&location_data->satellites);
 
-  gsa_sentence_parser->fix_type_.connect_to(&location_data->fix_type);
-  gsa_sentence_parser->hdop_.connect_to(&location_data->horizontal_dilution);
-  gsa_sentence_parser->pdop_.connect_to(&location_data->pdop);
-  gsa_sentence_parser->vdop_.connect_to(&location_data->vdop);
-
-  zda_sentence_parser->datetime_.connect_to(&location_data->datetime);
-
-  location_data->position.connect_to(
-      new SKOutput<Position>("navigation.position", "/SK Path/Position"));
-  location_data->rtk_quality.connect_to(new SKOutputString(
-      "navigation.gnss.methodQuality", "/SK Path/Fix Quality"));
-  location_data->num_satellites.connect_to(new SKOutputInt(
-      "navigation.gnss.satellites", "/SK Path/Number of Satellites",
-      new SKMetadata("", "Satellites")));
-  location_data->horizontal_dilution.connect_to(new SKOutputFloat(
-      "navigation.gnss.horizontalDilution", "/SK Path/Horizontal Dilution",
-      new SKMetadata("", "Horizontal Dilution of Precision")));
-  location_data->geoidal_separation.connect_to(new SKOutputFloat(
-      "navigation.gnss.geoidalSeparation", "/SK Path/Geoidal Separation",
-      new SKMetadata("m", "Geoidal Separation")));
-  location_data->dgps_age.connect_to(new SKOutputFloat(
-      "navigation.gnss.differentialAge", "/SK Path/Differential Age",
-      new SKMetadata("s", "Differential Age")));
-  location_data->dgps_id.connect_to(
-      new SKOutputFloat("navigation.gnss.differentialReference",
-                        "/SK Path/Differential Reference",
-                        new SKMetadata("", "Differential Reference Station ID")));
-  location_data->datetime.connect_to(
-      new SKOutputTime("navigation.datetime", "/SK Path/DateTime"));
-  location_data->speed.connect_to(new SKOutputFloat(
-      "navigation.speedOverGround", "/SK Path/Speed Over Ground",
-      new SKMetadata("m/s", "Speed Over Ground")));
-  location_data->true_course.connect_to(new SKOutputFloat(
-      "navigation.courseOverGroundTrue", "/SK Path/True Course Over Ground",
-      new SKMetadata("rad", "Course Over Ground (True)")));
-  location_data->variation.connect_to(new SKOutputFloat(
-      "navigation.magneticVariation", "/SK Path/Magnetic Variation",
-      new SKMetadata("rad", "Magnetic Variation")));
-  location_data->satellites.connect_to(new SKOutput<std::vector<GNSSSatellite>>(
-      "navigation.gnss.satellitesInView", "/SK Path/Satellites in View"));
+  location_data->position.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutput<Position>>("navigation.position",
+                                        "/SK Path/Position"),
+      output_policies));
+  location_data->rtk_quality.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutput<InternedString>>("navigation.gnss.methodQuality",
+                                              "/SK Path/Fix Quality"),
+      output_policies));
+  location_data->num_satellites.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputInt>("navigation.gnss.satellites",
+                                 "/SK Path/Number of Satellites",
+                                 WiringNew<SKMetadata>("", "Satellites")),
+      output_policies));
+  location_data->horizontal_dilution.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.horizontalDilution", "/SK Path/Horizontal Dilution",
+          WiringNew<SKMetadata>("", "Horizontal Dilution of Precision")),
+      output_policies));
+  location_data->geoidal_separation.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.gnss.geoidalSeparation",
+                                   "/SK Path/Geoidal Separation",
+                                   WiringNew<SKMetadata>("m",
+                                                         "Geoidal Separation")),
+      output_policies));
+  location_data->dgps_age.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.gnss.differentialAge",
+                                   "/SK Path/Differential Age",
+                                   WiringNew<SKMetadata>("s",
+                                                         "Differential Age")),
+      output_policies));
+  location_data->dgps_id.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.gnss.differentialReference",
+                                   "/SK Path/Differential Reference",
+                                   WiringNew<SKMetadata>(
+                                       "",
+                                       "Differential Reference Station ID")),
+      output_policies));
+  location_data->datetime.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputTime>("navigation.datetime", "/SK Path/DateTime"),
+      output_policies));
+  location_data->speed.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.speedOverGround",
+                                   "/SK Path/Speed Over Ground",
+                                   WiringNew<SKMetadata>("m/s",
+                                                         "Speed Over Ground")),
+      output_policies));
+  location_data->true_course.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.courseOverGroundTrue",
+                                   "/SK Path/True Course Over Ground",
+                                   WiringNew<SKMetadata>(
+                                       "rad", "Course Over Ground (True)")),
+      output_policies, true));
+  location_data->variation.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.magneticVariation",
+                                   "/SK Path/Magnetic Variation",
+                                   WiringNew<SKMetadata>("rad",
+                                                         "Magnetic Variation")),
+      output_policies, true));
+
+  // The satellite lists are streamed to JSON rather than built as a
+  // document per satellite.
+  if (!satellite_deltas) {
+    location_data->satellites.connect_to(WithOutputPolicy(
+        WiringNew<LazySKOutput<const GNSSSatelliteTable*,
+                               StreamingSKOutput<const GNSSSatelliteTable*>>>(
+            "navigation.gnss.satellitesInView",
+            "/SK Path/Satellites in View"),
+        output_policies));
+    return;
+  }
+
+  // The full satellite list is sent every few cycles only, and the changes
+  // in between. An output policy on the delta path would lose changes.
+  auto* satellite_delta = WiringNew<GNSSSatelliteDeltaTransform>(
+      kGNSSSatelliteKeyframeInterval, "/GNSS/Satellite Delta");
+  location_data->satellites.connect_to(satellite_delta);
+  satellite_delta->keyframe_.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutput<const GNSSSatelliteTable*,
+                             StreamingSKOutput<const GNSSSatelliteTable*>>>(
+          "navigation.gnss.satellitesInView",
+          "/SK Path/Satellites in View"),
+      output_policies));
+  satellite_delta->connect_to(
+      WiringNew<LazySKOutput<const GNSSSatelliteDelta*,
+                             StreamingSKOutput<const GNSSSatelliteDelta*>>>(
+          "navigation.gnss.satellitesInViewDelta",
+          "/SK Path/Satellites in View Delta"));
 }
 
-void ConnectSkyTraqRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data) {
+void ConnectSkyTraqRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data,
+                       const OutputPolicies& output_policies) {
+  BootPhase boot_phase("ConnectSkyTraqRTK");
   SkyTraqPSTI030SentenceParser* psti030_sentence_parser =
-      new SkyTraqPSTI030SentenceParser(nmea_input);
+      WiringNew<SkyTraqPSTI030SentenceParser>(nmea_input);
 
   SkyTraqPSTI032SentenceParser* psti032_sentence_parser =
-      new SkyTraqPSTI032SentenceParser(nmea_input);
+      WiringNew<SkyTraqPSTI032SentenceParser>(nmea_input);
 
   psti030_sentence_parser->position_.connect_to(&rtk_data->position);
   psti030_sentence_parser->datetime_.connect_to(&rtk_data->datetime);
@@ -120,64 +215,91 @@ void ConnectSkyTraqRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data) {
   psti032_sentence_parser->baseline_course_.connect_to(
       &rtk_data->baseline_course);
 
-  rtk_data->rtk_age.connect_to(new SKOutputFloat(
-      "navigation.gnss.rtkAge", "/SK Path/RTK Age",
-      new SKMetadata("s", "RTK Solution Age", "The age of the RTK solution",
-                     "RTK Age", 30)));
-  rtk_data->rtk_ratio.connect_to(new SKOutputFloat(
-      "navigation.gnss.rtkRatio", "/SK Path/RTK Ratio",
-      new SKMetadata("", "RTK Ratio", "RTK solution quality indicator",
-                     "RTK Ratio", 30)));
-  rtk_data->baseline_length.connect_to(new SKOutputFloat(
-      "navigation.gnss.rtkBaselineLength", "/SK Path/RTK Baseline Length",
-      new SKMetadata("m", "RTK Baseline Length",
-                     "Distance between the RTK antennas", "RTK Baseline Length",
-                     30)));
-  rtk_data->baseline_course
-      .connect_to(new SKOutputFloat(
+  rtk_data->rtk_age.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.rtkAge", "/SK Path/RTK Age",
+          WiringNew<SKMetadata>("s", "RTK Solution Age",
+                                "The age of the RTK solution", "RTK Age", 30)),
+      output_policies));
+  rtk_data->rtk_ratio.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.rtkRatio", "/SK Path/RTK Ratio",
+          WiringNew<SKMetadata>("", "RTK Ratio",
+                                "RTK solution quality indicator", "RTK Ratio",
+                                30)),
+      output_policies));
+  rtk_data->baseline_length.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.rtkBaselineLength", "/SK Path/RTK Baseline Length",
+          WiringNew<SKMetadata>("m", "RTK Baseline Length",
+                                "Distance between the RTK antennas",
+                                "RTK Baseline Length", 30)),
+      output_policies));
+  // The policy of the baseline course also paces the heading derived from it
+  ApplyOutputPolicy(&rtk_data->baseline_course, output_policies,
+                    "navigation.gnss.rtkBaselineCourse",
+                    "/SK Path/RTK Baseline Course", true)
+      ->connect_to(WiringNew<LazySKOutputFloat>(
           "navigation.gnss.rtkBaselineCourse", "/SK Path/RTK Baseline Course",
-          new SKMetadata("deg", "RTK Baseline Course",
-                         "Angle between baseline vector and north",
-                         "RTK Baseline Course", 30)))
-      ->connect_to(new AngleCorrection(0, 0, "/RTK/Heading Correction"))
-      ->connect_to(new SKOutputFloat("navigation.headingTrue",
-                                     "/SK Path/RTK Heading True"));
+          WiringNew<SKMetadata>("deg", "RTK Baseline Course",
+                                "Angle between baseline vector and north",
+                                "RTK Baseline Course", 30)))
+      ->connect_to(WiringNew<AngleCorrection>(0, 0, "/RTK/Heading Correction"))
+      ->connect_to(WiringNew<LazySKOutputFloat>("navigation.headingTrue",
+                                                "/SK Path/RTK Heading True"));
 }
 
-void ConnectQuectelRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data) {
+void ConnectQuectelRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data,
+                       const OutputPolicies& output_policies) {
+  BootPhase boot_phase("ConnectQuectelRTK");
   QuectelPQTMTARSentenceParser* pqtmtar_sentence_parser =
-      new QuectelPQTMTARSentenceParser(nmea_input);
+      WiringNew<QuectelPQTMTARSentenceParser>(nmea_input);
 
   pqtmtar_sentence_parser->datetime_.connect_to(&rtk_data->datetime);
   pqtmtar_sentence_parser->rtk_quality_.connect_to(&rtk_data->rtk_quality);
   pqtmtar_sentence_parser->baseline_length_.connect_to(
       &rtk_data->baseline_length);
-  pqtmtar_sentence_parser->attitude_
-      .connect_to(new LambdaTransform<sensesp::AttitudeVector, float>(
-          [](const AttitudeVector& attitude) { return attitude.yaw; }))
-      ->connect_to(new SKOutputFloat("navigation.gnss.rtkBaselineCourse",
-                                     "/SK Path/RTK Yaw"))
-      ->connect_to(new AngleCorrection(0, 0, "/RTK/Heading Correction"))
-      ->connect_to(new SKOutputFloat("navigation.headingTrue",
-                                     "/SK Path/RTK Heading True"));
+  // The yaw of PQTMTAR is in degrees, which the angular average does not
+  // handle, so it is averaged as a plain number
+  ApplyOutputPolicy(
+      pqtmtar_sentence_parser->attitude_.connect_to(
+          WiringNew<LambdaTransform<sensesp::AttitudeVector, float>>(
+              [](const AttitudeVector& attitude) { return attitude.yaw; })),
+      output_policies, "navigation.gnss.rtkBaselineCourse", "/SK Path/RTK Yaw",
+      false)
+      ->connect_to(WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.rtkBaselineCourse", "/SK Path/RTK Yaw"))
+      ->connect_to(WiringNew<AngleCorrection>(0, 0, "/RTK/Heading Correction"))
+      ->connect_to(WiringNew<LazySKOutputFloat>("navigation.headingTrue",
+                                                "/SK Path/RTK Heading True"));
   pqtmtar_sentence_parser->attitude_.connect_to(&rtk_data->attitude);
   pqtmtar_sentence_parser->hdg_num_satellites_.connect_to(
       &rtk_data->rtk_num_satellites);
 
-  rtk_data->rtk_age.connect_to(new SKOutputFloat(
-      "navigation.gnss.rtkAge", "/SK Path/RTK Age",
-      new SKMetadata("s", "RTK Solution Age", "The age of the RTK solution",
-                     "RTK Age", 30)));
-  rtk_data->rtk_ratio.connect_to(new SKOutputFloat(
-      "navigation.gnss.rtkRatio", "/SK Path/RTK Ratio",
-      new SKMetadata("", "RTK Ratio", "RTK solution quality indicator",
-                     "RTK Ratio", 30)));
+  rtk_data->rtk_age.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.rtkAge", "/SK Path/RTK Age",
+          WiringNew<SKMetadata>("s", "RTK Solution Age",
+                                "The age of the RTK solution", "RTK Age", 30)),
+      output_policies));
+  rtk_data->rtk_ratio.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.gnss.rtkRatio", "/SK Path/RTK Ratio",
+          WiringNew<SKMetadata>("", "RTK Ratio",
+                                "RTK solution quality indicator", "RTK Ratio",
+                                30)),
+      output_policies));
 }
 
 void ConnectApparentWind(NMEA0183Parser* nmea_input,
-                         ApparentWindData* apparent_wind_data) {
-  auto* mwv = new MWVSentenceParser(nmea_input);
-  auto* vwr = new VWRSentenceParser(nmea_input);
+                         ApparentWindData* apparent_wind_data,
+                         const OutputPolicies& output_policies,
+                         const DeadbandSettings& angle_deadband) {
+  BootPhase boot_phase("ConnectApparentWind");
+  auto* mwv = WiringNew<MWVSentenceParser>(nmea_input);
+  auto* vwr = WiringNew<VWRSentenceParser>(nmea_input);
+
+  mwv->apparent_wind_angle_.set_settings(angle_deadband);
 
   mwv->apparent_wind_speed_.connect_to(&apparent_wind_data->speed);
   mwv->apparent_wind_angle_.connect_to(&apparent_wind_data->angle);
@@ -185,44 +307,66 @@ void ConnectApparentWind(NMEA0183Parser* nmea_input,
   vwr->apparent_wind_speed_.connect_to(&apparent_wind_data->speed);
   vwr->apparent_wind_angle_.connect_to(&apparent_wind_data->angle);
 
-  apparent_wind_data->angle.connect_to(new SKOutputFloat(
-      "environment.wind.angleApparent", "/SK Path/Apparent Wind Angle"));
-  apparent_wind_data->speed.connect_to(new SKOutputFloat(
-      "environment.wind.speedApparent", "/SK Path/Apparent Wind Speed"));
+  apparent_wind_data->angle.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.wind.angleApparent",
+                                   "/SK Path/Apparent Wind Angle"),
+      output_policies, true));
+  apparent_wind_data->speed.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.wind.speedApparent",
+                                   "/SK Path/Apparent Wind Speed"),
+      output_policies));
 }
 
 void ConnectDepthTemperature(NMEA0183Parser* nmea_input,
-                             DepthTemperatureData* data) {
-  auto* dbt = new DBTSentenceParser(nmea_input);
-  auto* mtw = new MTWSentenceParser(nmea_input);
+                             DepthTemperatureData* data,
+                             const OutputPolicies& output_policies,
+                             const DeadbandSettings& depth_deadband) {
+  BootPhase boot_phase("ConnectDepthTemperature");
+  auto* dbt = WiringNew<DBTSentenceParser>(nmea_input);
+  auto* mtw = WiringNew<MTWSentenceParser>(nmea_input);
+
+  dbt->depth_.set_settings(depth_deadband);
 
   dbt->depth_.connect_to(&data->depth_below_transducer);
   mtw->water_temperature_.connect_to(&data->water_temperature);
 
-  data->depth_below_transducer.connect_to(new SKOutputFloat(
-      "environment.depth.belowTransducer",
-      "/SK Path/Depth Below Transducer"));
-  data->water_temperature.connect_to(new SKOutputFloat(
-      "environment.water.temperature",
-      "/SK Path/Water Temperature"));
+  data->depth_below_transducer.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.depth.belowTransducer",
+                                   "/SK Path/Depth Below Transducer"),
+      output_policies));
+  data->water_temperature.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.water.temperature",
+                                   "/SK Path/Water Temperature"),
+      output_policies));
 }
 
-void ConnectHeading(NMEA0183Parser* nmea_input, HeadingData* data) {
-  auto* hdm = new HDMSentenceParser(nmea_input);
-  auto* hdt = new HDTSentenceParser(nmea_input);
+void ConnectHeading(NMEA0183Parser* nmea_input, HeadingData* data,
+                    const OutputPolicies& output_policies,
+                    const DeadbandSettings& true_heading_deadband) {
+  BootPhase boot_phase("ConnectHeading");
+  auto* hdm = WiringNew<HDMSentenceParser>(nmea_input);
+  auto* hdt = WiringNew<HDTSentenceParser>(nmea_input);
+
+  hdt->true_heading_.set_settings(true_heading_deadband);
 
   hdm->magnetic_heading_.connect_to(&data->magnetic_heading);
   hdt->true_heading_.connect_to(&data->true_heading);
 
-  data->magnetic_heading.connect_to(new SKOutputFloat(
-      "navigation.headingMagnetic", "/SK Path/Heading Magnetic"));
-  data->true_heading.connect_to(new SKOutputFloat(
-      "navigation.headingTrue", "/SK Path/Heading True"));
+  data->magnetic_heading.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.headingMagnetic",
+                                   "/SK Path/Heading Magnetic"),
+      output_policies, true));
+  data->true_heading.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.headingTrue",
+                                   "/SK Path/Heading True"),
+      output_policies, true));
 }
 
-void ConnectTrueWind(NMEA0183Parser* nmea_input, TrueWindData* data) {
-  auto* mwd = new MWDSentenceParser(nmea_input);
-  auto* mwv_true = new TrueWindMWVSentenceParser(nmea_input);
+void ConnectTrueWind(NMEA0183Parser* nmea_input, TrueWindData* data,
+                     const OutputPolicies& output_policies) {
+  BootPhase boot_phase("ConnectTrueWind");
+  auto* mwd = WiringNew<MWDSentenceParser>(nmea_input);
+  auto* mwv_true = WiringNew<TrueWindMWVSentenceParser>(nmea_input);
 
   mwd->true_wind_direction_.connect_to(&data->direction);
   mwd->true_wind_speed_.connect_to(&data->speed);
@@ -230,14 +374,20 @@ void ConnectTrueWind(NMEA0183Parser* nmea_input, TrueWindData* data) {
   mwv_true->true_wind_direction_.connect_to(&data->direction);
   mwv_true->true_wind_speed_.connect_to(&data->speed);
 
-  data->direction.connect_to(new SKOutputFloat(
-      "environment.wind.directionTrue", "/SK Path/True Wind Direction"));
-  data->speed.connect_to(new SKOutputFloat(
-      "environment.wind.speedTrue", "/SK Path/True Wind Speed"));
+  data->direction.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.wind.directionTrue",
+                                   "/SK Path/True Wind Direction"),
+      output_policies, true));
+  data->speed.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.wind.speedTrue",
+                                   "/SK Path/True Wind Speed"),
+      output_policies));
 }
 
-void ConnectWeather(NMEA0183Parser* nmea_input, WeatherData* data) {
-  auto* mda = new MDASentenceParser(nmea_input);
+void ConnectWeather(NMEA0183Parser* nmea_input, WeatherData* data,
+                    const OutputPolicies& output_policies) {
+  BootPhase boot_phase("ConnectWeather");
+  auto* mda = WiringNew<MDASentenceParser>(nmea_input);
 
   mda->barometric_pressure_.connect_to(&data->barometric_pressure);
   mda->air_temperature_.connect_to(&data->air_temperature);
@@ -247,27 +397,74 @@ void ConnectWeather(NMEA0183Parser* nmea_input, WeatherData* data) {
   mda->true_wind_direction_.connect_to(&data->true_wind_direction);
   mda->true_wind_speed_.connect_to(&data->true_wind_speed);
 
-  data->barometric_pressure.connect_to(new SKOutputFloat(
-      "environment.outside.pressure", "/SK Path/Barometric Pressure"));
-  data->air_temperature.connect_to(new SKOutputFloat(
-      "environment.outside.temperature", "/SK Path/Air Temperature"));
-  data->water_temperature.connect_to(new SKOutputFloat(
-      "environment.water.temperature", "/SK Path/Water Temperature (MDA)"));
-  data->relative_humidity.connect_to(new SKOutputFloat(
-      "environment.outside.humidity", "/SK Path/Relative Humidity"));
-  data->dew_point.connect_to(new SKOutputFloat(
-      "environment.outside.dewPointTemperature", "/SK Path/Dew Point"));
-  data->true_wind_direction.connect_to(new SKOutputFloat(
-      "environment.wind.directionTrue", "/SK Path/True Wind Direction (MDA)"));
-  data->true_wind_speed.connect_to(new SKOutputFloat(
-      "environment.wind.speedTrue", "/SK Path/True Wind Speed (MDA)"));
+  data->barometric_pressure.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.outside.pressure",
+                                   "/SK Path/Barometric Pressure"),
+      output_policies));
+  data->air_temperature.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.outside.temperature",
+                                   "/SK Path/Air Temperature"),
+      output_policies));
+  data->water_temperature.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.water.temperature",
+                                   "/SK Path/Water Temperature (MDA)"),
+      output_policies));
+  data->relative_humidity.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.outside.humidity",
+                                   "/SK Path/Relative Humidity"),
+      output_policies));
+  data->dew_point.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.outside.dewPointTemperature",
+                                   "/SK Path/Dew Point"),
+      output_policies));
+  data->true_wind_direction.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.wind.directionTrue",
+                                   "/SK Path/True Wind Direction (MDA)"),
+      output_policies, true));
+  data->true_wind_speed.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("environment.wind.speedTrue",
+                                   "/SK Path/True Wind Speed (MDA)"),
+      output_policies));
 }
 
-void ConnectWaypoint(NMEA0183Parser* nmea_input, WaypointData* data) {
-  auto* rmb = new RMBSentenceParser(nmea_input);
-  auto* bwc = new BWCSentenceParser(nmea_input);
-  auto* apb = new APBSentenceParser(nmea_input);
-  new WPLSentenceParser(nmea_input);  // registered but not wired to SK
+void ConnectWaypoint(NMEA0183Parser* nmea_input, WaypointData* data,
+                     const OutputPolicies& output_policies,
+                     WaypointDatabase* database) {
+  BootPhase boot_phase("ConnectWaypoint");
+  auto* rmb = WiringNew<RMBSentenceParser>(nmea_input);
+  auto* bwc = WiringNew<BWCSentenceParser>(nmea_input);
+  auto* apb = WiringNew<APBSentenceParser>(nmea_input);
+  auto* wpl = WiringNew<WPLSentenceParser>(nmea_input);  // not wired to SK
+
+  if (database != nullptr) {
+    // The ID is set after the position in WPL, and before it in BWC. The
+    // outputs only read with get() must not be skipped by lazy parsers.
+    wpl->position_.set_observed();
+    bwc->waypoint_id_.set_observed();
+    wpl->waypoint_id_.attach([wpl, database]() {
+      const Position& position = wpl->position_.get();
+      database->set_position(wpl->waypoint_id_.get().c_str(),
+                             position.latitude, position.longitude);
+    });
+    bwc->waypoint_position_.attach([bwc, database]() {
+      const WaypointID& id = bwc->waypoint_id_.get();
+      if (id.length() > 0) {
+        const Position& position = bwc->waypoint_position_.get();
+        database->set_position(id.c_str(), position.latitude,
+                               position.longitude);
+      }
+    });
+
+    auto* rte = WiringNew<RTESentenceParser>(nmea_input);
+    auto* route_resolver = WiringNew<RouteResolver>(database);
+    rte->route_id_.set_observed();
+    rte->waypoints_.attach([rte, route_resolver]() {
+      const RouteWaypoints* waypoints = rte->waypoints_.get();
+      route_resolver->set_route(rte->route_id_.get().c_str(), waypoints->ids,
+                                waypoints->size);
+    });
+    route_resolver->connect_to(&data->route);
+  }
 
   rmb->cross_track_error_.connect_to(&data->cross_track_error);
   rmb->bearing_to_destination_.connect_to(&data->bearing_to_destination);
@@ -282,46 +479,122 @@ void ConnectWaypoint(NMEA0183Parser* nmea_input, WaypointData* data) {
 
   apb->heading_to_steer_.connect_to(&data->heading_to_steer);
 
-  data->cross_track_error.connect_to(new SKOutputFloat(
-      "navigation.courseRhumbline.crossTrackError",
-      "/SK Path/Cross Track Error"));
-  data->bearing_to_destination.connect_to(new SKOutputFloat(
-      "navigation.courseRhumbline.bearingTrackTrue",
-      "/SK Path/Bearing to Destination"));
-  data->range_to_destination.connect_to(new SKOutputFloat(
-      "navigation.courseRhumbline.nextPoint.distance",
-      "/SK Path/Range to Destination"));
-  data->destination_closing_velocity.connect_to(new SKOutputFloat(
-      "navigation.courseRhumbline.nextPoint.velocityMadeGood",
-      "/SK Path/Closing Velocity"));
-  data->heading_to_steer.connect_to(new SKOutputFloat(
-      "steering.autopilot.target.headingTrue",
-      "/SK Path/Heading to Steer"));
-  data->gc_bearing_true.connect_to(new SKOutputFloat(
-      "navigation.courseGreatCircle.bearingTrackTrue",
-      "/SK Path/GC Bearing True"));
-  data->gc_distance.connect_to(new SKOutputFloat(
-      "navigation.courseGreatCircle.nextPoint.distance",
-      "/SK Path/GC Distance"));
+  data->cross_track_error.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.courseRhumbline.crossTrackError",
+                                   "/SK Path/Cross Track Error"),
+      output_policies));
+  data->bearing_to_destination.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.courseRhumbline.bearingTrackTrue",
+          "/SK Path/Bearing to Destination"),
+      output_policies, true));
+  data->range_to_destination.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.courseRhumbline.nextPoint.distance",
+          "/SK Path/Range to Destination"),
+      output_policies));
+  data->destination_closing_velocity.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.courseRhumbline.nextPoint.velocityMadeGood",
+          "/SK Path/Closing Velocity"),
+      output_policies));
+  data->heading_to_steer.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("steering.autopilot.target.headingTrue",
+                                   "/SK Path/Heading to Steer"),
+      output_policies, true));
+  data->gc_bearing_true.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.courseGreatCircle.bearingTrackTrue",
+          "/SK Path/GC Bearing True"),
+      output_policies, true));
+  data->gc_distance.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>(
+          "navigation.courseGreatCircle.nextPoint.distance",
+          "/SK Path/GC Distance"),
+      output_policies));
 }
 
 void ConnectGNSSIntegrity(NMEA0183Parser* nmea_input,
-                          GNSSIntegrityData* data) {
-  auto* gbs = new GBSSentenceParser(nmea_input);
+                          GNSSIntegrityData* data,
+                          const OutputPolicies& output_policies) {
+  BootPhase boot_phase("ConnectGNSSIntegrity");
+  auto* gbs = WiringNew<GBSSentenceParser>(nmea_input);
 
   gbs->lat_error_.connect_to(&data->lat_error);
   gbs->lon_error_.connect_to(&data->lon_error);
   gbs->alt_error_.connect_to(&data->alt_error);
 
-  data->lat_error.connect_to(new SKOutputFloat(
-      "navigation.gnss.integrity.latitudeError",
-      "/SK Path/GNSS Latitude Error"));
-  data->lon_error.connect_to(new SKOutputFloat(
-      "navigation.gnss.integrity.longitudeError",
-      "/SK Path/GNSS Longitude Error"));
-  data->alt_error.connect_to(new SKOutputFloat(
-      "navigation.gnss.integrity.altitudeError",
-      "/SK Path/GNSS Altitude Error"));
+  data->lat_error.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.gnss.integrity.latitudeError",
+                                   "/SK Path/GNSS Latitude Error"),
+      output_policies));
+  data->lon_error.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.gnss.integrity.longitudeError",
+                                   "/SK Path/GNSS Longitude Error"),
+      output_policies));
+  data->alt_error.connect_to(WithOutputPolicy(
+      WiringNew<LazySKOutputFloat>("navigation.gnss.integrity.altitudeError",
+                                   "/SK Path/GNSS Altitude Error"),
+      output_policies));
+}
+
+void ConnectNavigationSnapshot(NavigationSnapshot* snapshot,
+                               GNSSData* location_data,
+                               HeadingData* heading_data,
+                               ApparentWindData* apparent_wind_data) {
+  BootPhase boot_phase("ConnectNavigationSnapshot");
+  if (location_data != nullptr) {
+    location_data->fix.attach([snapshot, location_data]() {
+      const GNSSFix& fix = location_data->fix.get();
+      uint32_t now = millis();
+      snapshot->write([&fix, now](NavigationState* state) {
+        if (fix.position.latitude != kInvalidDouble &&
+            fix.position.longitude != kInvalidDouble) {
+          state->position.set(fix.position, now);
+        }
+        if (fix.speed != kInvalidFloat) {
+          state->speed_over_ground.set(fix.speed, now);
+        }
+        if (fix.true_course != kInvalidFloat) {
+          state->course_over_ground_true.set(fix.true_course, now);
+        }
+      });
+    });
+  }
+
+  if (heading_data != nullptr) {
+    heading_data->true_heading.attach([snapshot, heading_data]() {
+      float heading = heading_data->true_heading.get();
+      uint32_t now = millis();
+      snapshot->write([heading, now](NavigationState* state) {
+        state->heading_true.set(heading, now);
+      });
+    });
+    heading_data->magnetic_heading.attach([snapshot, heading_data]() {
+      float heading = heading_data->magnetic_heading.get();
+      uint32_t now = millis();
+      snapshot->write([heading, now](NavigationState* state) {
+        state->heading_magnetic.set(heading, now);
+      });
+    });
+  }
+
+  if (apparent_wind_data != nullptr) {
+    apparent_wind_data->angle.attach([snapshot, apparent_wind_data]() {
+      float angle = apparent_wind_data->angle.get();
+      uint32_t now = millis();
+      snapshot->write([angle, now](NavigationState* state) {
+        state->apparent_wind_angle.set(angle, now);
+      });
+    });
+    apparent_wind_data->speed.attach([snapshot, apparent_wind_data]() {
+      float speed = apparent_wind_data->speed.get();
+      uint32_t now = millis();
+      snapshot->write([speed, now](NavigationState* state) {
+        state->apparent_wind_speed.set(speed, now);
+      });
+    });
+  }
 }
 
 }  // namespace sensesp::nmea0183
@@ -1,76 +1,131 @@
 #ifndef SENSEP_NMEA0183_WIRING_H
 #define SENSEP_NMEA0183_WIRING_H
 
+#include "sensesp_nmea0183/boot_report.h"
 #include "sensesp_nmea0183/data/gnss_data.h"
 #include "sensesp_nmea0183/data/navigation_data.h"
+#include "sensesp_nmea0183/data/navigation_snapshot.h"
 #include "sensesp_nmea0183/data/waypoint_data.h"
+#include "sensesp_nmea0183/data/waypoint_database.h"
 #include "sensesp_nmea0183/data/weather_data.h"
 #include "sensesp_nmea0183/data/wind_data.h"
 #include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/deadband_value.h"
+#include "sensesp_nmea0183/transforms/output_policy.h"
+#include "sensesp_nmea0183/wiring_arena.h"
 
 namespace sensesp::nmea0183 {
 
 /**
  * @brief GNSSData observable members to SK outputs.
  *
+ * GGA, RMC, GLL, GSA, VTG and ZDA sentences are merged per epoch by a
+ * GNSSEpochAssembler, so GNSSData::fix and the individual members are
+ * updated once per fix.
+ *
+ * navigation.gnss.satellitesInView carries the whole satellite list of
+ * every GSV cycle.
+ *
  * @param nmea_input
+ * @param output_policies Rate limiting per Signal K path, see OutputPolicies
+ * @param satellite_deltas Send the whole satellite list only every
+ * kGNSSSatelliteKeyframeInterval GSV cycles, and the changes in between to
+ * navigation.gnss.satellitesInViewDelta, which is not a standard Signal K
+ * path
  */
-void ConnectGNSS(NMEA0183Parser* nmea_input, GNSSData* location_data);
+void ConnectGNSS(NMEA0183Parser* nmea_input, GNSSData* location_data,
+                 const OutputPolicies& output_policies = {},
+                 bool satellite_deltas = false);
 
 /**
  * @brief Wire the SkyTraq RTK Data observable members to SK outputs.
  *
  * @param nmea_input
  * @param rtk_data
+ * @param output_policies Rate limiting per Signal K path, see OutputPolicies
  */
-void ConnectSkyTraqRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data);
+void ConnectSkyTraqRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data,
+                       const OutputPolicies& output_policies = {});
 
 /**
  * @brief Wire the Quectel RTK Data observable members to SK outputs.
  *
  * @param nmea_input
  * @param rtk_data
+ * @param output_policies Rate limiting per Signal K path, see OutputPolicies
  */
-void ConnectQuectelRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data);
+void ConnectQuectelRTK(NMEA0183Parser* nmea_input, RTKData* rtk_data,
+                       const OutputPolicies& output_policies = {});
 
 /**
  * @brief Wire the ApparentWindData observable members to SK outputs.
  *
+ * @param angle_deadband Change filtering of the MWV apparent wind angle
  */
 void ConnectApparentWind(NMEA0183Parser* nmea_input,
-                         ApparentWindData* apparent_wind_data);
+                         ApparentWindData* apparent_wind_data,
+                         const OutputPolicies& output_policies = {},
+                         const DeadbandSettings& angle_deadband = {});
 
 /**
  * @brief Wire DBT and MTW parsers to Signal K outputs.
+ *
+ * @param depth_deadband Change filtering of the DBT depth, e.g. 0.01 m
  */
 void ConnectDepthTemperature(NMEA0183Parser* nmea_input,
-                             DepthTemperatureData* data);
+                             DepthTemperatureData* data,
+                             const OutputPolicies& output_policies = {},
+                             const DeadbandSettings& depth_deadband = {});
 
 /**
  * @brief Wire HDM and HDT parsers to Signal K outputs.
+ *
+ * @param true_heading_deadband Change filtering of the HDT heading, in
+ * radians
  */
-void ConnectHeading(NMEA0183Parser* nmea_input, HeadingData* data);
+void ConnectHeading(NMEA0183Parser* nmea_input, HeadingData* data,
+                    const OutputPolicies& output_policies = {},
+                    const DeadbandSettings& true_heading_deadband = {});
 
 /**
  * @brief Wire MWD parser to Signal K outputs for true wind data.
  */
-void ConnectTrueWind(NMEA0183Parser* nmea_input, TrueWindData* data);
+void ConnectTrueWind(NMEA0183Parser* nmea_input, TrueWindData* data,
+                     const OutputPolicies& output_policies = {});
 
 /**
  * @brief Wire MDA parser to Signal K outputs for weather data.
  */
-void ConnectWeather(NMEA0183Parser* nmea_input, WeatherData* data);
+void ConnectWeather(NMEA0183Parser* nmea_input, WeatherData* data,
+                    const OutputPolicies& output_policies = {});
 
 /**
  * @brief Wire RMB, BWC, and APB parsers to Signal K outputs.
+ *
+ * If a database is given, WPL and BWC waypoint positions are stored in it,
+ * and RTE routes are resolved against it into data->route.
  */
-void ConnectWaypoint(NMEA0183Parser* nmea_input, WaypointData* data);
+void ConnectWaypoint(NMEA0183Parser* nmea_input, WaypointData* data,
+                     const OutputPolicies& output_policies = {},
+                     WaypointDatabase* database = nullptr);
 
 /**
  * @brief Wire GBS parser to Signal K outputs for GNSS error estimates.
  */
 void ConnectGNSSIntegrity(NMEA0183Parser* nmea_input,
-                          GNSSIntegrityData* data);
+                          GNSSIntegrityData* data,
+                          const OutputPolicies& output_policies = {});
+
+/**
+ * @brief Keep a NavigationSnapshot up to date with the data containers.
+ *
+ * Position, speed and course are written once per GNSS epoch. Any of the
+ * containers may be nullptr.
+ */
+void ConnectNavigationSnapshot(NavigationSnapshot* snapshot,
+                               GNSSData* location_data,
+                               HeadingData* heading_data,
+                               ApparentWindData* apparent_wind_data);
 
 }  // namespace sensesp::nmea0183
 
@@ -0,0 +1,42 @@
+#include "wiring_arena.h"
+
+namespace sensesp::nmea0183 {
+
+static size_t AlignUp(size_t offset, size_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+WiringArena::WiringArena(void* buffer, size_t size)
+    : buffer_{static_cast<uint8_t*>(buffer)}, capacity_{size} {
+  // Offsets are aligned relative to the start of the buffer, so start it at
+  // the strictest alignment
+  if (buffer_ != nullptr) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(buffer_);
+    size_t padding = AlignUp(address, alignof(std::max_align_t)) - address;
+    padding = padding > capacity_ ? capacity_ : padding;
+    buffer_ += padding;
+    capacity_ -= padding;
+  }
+}
+
+void* WiringArena::allocate(size_t size, size_t alignment) {
+  required_ = AlignUp(required_, alignment) + size;
+  size_t offset = AlignUp(used_, alignment);
+  if (buffer_ == nullptr || offset + size > capacity_) {
+    overflow_count_++;
+    return nullptr;
+  }
+  used_ = offset + size;
+  object_count_++;
+  return buffer_ + offset;
+}
+
+void WiringArena::log_footprint() const {
+  ESP_LOGI("SensESP/NMEA0183",
+           "Wiring arena: %u of %u bytes used by %u objects, %u bytes "
+           "required, %u objects on heap",
+           (unsigned)used_, (unsigned)capacity_, object_count_,
+           (unsigned)required_, overflow_count_);
+}
+
+}  // namespace sensesp::nmea0183
@@ -0,0 +1,117 @@
+#ifndef SENSESP_NMEA0183_WIRING_ARENA_H_
+#define SENSESP_NMEA0183_WIRING_ARENA_H_
+
+#include <Arduino.h>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace sensesp::nmea0183 {
+
+/**
+ * @brief Bump allocator for the objects created by the wiring helpers.
+ *
+ * The parsers, transforms, Signal K outputs and metadata that the Connect*
+ * functions create live for the lifetime of the program. While an arena is
+ * active, WiringNew() places them in its buffer instead of the heap, so they
+ * take one block of a size known in advance:
+ *
+ *   static StaticWiringArena<8192> arena;
+ *   arena.wire("GNSS", [&]() { ConnectGNSS(nmea, gnss_data); });
+ *
+ * An object that doesn't fit is allocated on the heap as before. required()
+ * tracks the size an arena would need to hold all objects, including those,
+ * so an arena constructed without a buffer measures the footprint of a
+ * wiring without placing anything.
+ *
+ * Only the objects created directly by the wiring helpers are placed in the
+ * arena; memory allocated by their constructors, such as strings and
+ * observer lists, still comes from the heap. Objects in an arena are never
+ * destroyed.
+ */
+class WiringArena {
+ public:
+  /// Arena using size bytes of buffer
+  WiringArena(void* buffer, size_t size);
+  /// Arena that only measures
+  WiringArena() : WiringArena(nullptr, 0) {}
+  WiringArena(const WiringArena&) = delete;
+  WiringArena& operator=(const WiringArena&) = delete;
+
+  /// The arena new wiring objects are placed in, or nullptr
+  static WiringArena* active() { return active_; }
+
+  /// Reserve size bytes, or return nullptr if they don't fit
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * @brief Call connect with this arena active and log its footprint.
+   *
+   * @param name Name of the wiring in the log
+   * @return False if some objects had to be allocated on the heap
+   */
+  template <typename F>
+  bool wire(const char* name, F connect) {
+    size_t required_before = required_;
+    unsigned int overflow_before = overflow_count_;
+    WiringArena* previous = active_;
+    active_ = this;
+    connect();
+    active_ = previous;
+    ESP_LOGI("SensESP/NMEA0183", "Wiring %s: %u bytes, %u on heap", name,
+             (unsigned)(required_ - required_before),
+             overflow_count_ - overflow_before);
+    return overflow_count_ == overflow_before;
+  }
+
+  /// Log the footprint of everything wired so far
+  void log_footprint() const;
+
+  size_t get_capacity() const { return capacity_; }
+  /// Bytes placed in the arena, including alignment padding
+  size_t get_used() const { return used_; }
+  /// Bytes an arena needs to place every object requested so far
+  size_t get_required() const { return required_; }
+  /// Number of objects placed in the arena
+  unsigned int get_object_count() const { return object_count_; }
+  /// Number of objects allocated on the heap because they didn't fit
+  unsigned int get_overflow_count() const { return overflow_count_; }
+
+ protected:
+  static inline WiringArena* active_ = nullptr;
+
+  uint8_t* buffer_;
+  size_t capacity_;
+  size_t used_ = 0;
+  size_t required_ = 0;
+  unsigned int object_count_ = 0;
+  unsigned int overflow_count_ = 0;
+};
+
+/// WiringArena with a buffer of kSize bytes of its own
+template <size_t kSize>
+class StaticWiringArena : public WiringArena {
+ public:
+  StaticWiringArena() : WiringArena(buffer_, kSize) {}
+
+ protected:
+  alignas(std::max_align_t) uint8_t buffer_[kSize];
+};
+
+/// Create a wiring object in the active WiringArena, or on the heap
+template <typename T, typename... Args>
+T* WiringNew(Args&&... args) {
+  WiringArena* arena = WiringArena::active();
+  if (arena != nullptr) {
+    void* memory = arena->allocate(sizeof(T), alignof(T));
+    if (memory != nullptr) {
+      return new (memory) T(std::forward<Args>(args)...);
+    }
+  }
+  return new T(std::forward<Args>(args)...);
+}
+
+}  // namespace sensesp::nmea0183
+
+#endif  // SENSESP_NMEA0183_WIRING_ARENA_H_
@@ -0,0 +1,165 @@
+#include <unity.h>
+
+#include <string>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/data/json_writer.h"
+#include "sensesp_nmea0183/io/capture.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/navigation_sentence_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static const char* kHDT = "$HCHDT,98.3,T*1B\r\n";
+static const char* kHDM = "$HCHDM,101.1,M*28\r\n";
+
+static void Record(CaptureWriter& writer, uint8_t source, const char* data,
+                   uint32_t time_us) {
+  writer.write(source, reinterpret_cast<const uint8_t*>(data), strlen(data),
+               time_us);
+}
+
+/// A capture of HDT at 0 ms and 500 ms from source 0 and HDM at 100 ms
+/// from source 1. The event loop may keep references to it.
+static const uint8_t* MakeCapture(size_t* length) {
+  auto* capture = new StringPrint();
+  CaptureWriter writer(capture);
+  Record(writer, 0, kHDT, 1000);
+  Record(writer, 1, kHDM, 101000);
+  Record(writer, 0, kHDT, 501000);
+  *length = capture->length();
+  return reinterpret_cast<const uint8_t*>(capture->c_str());
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_capture_format(void) {
+  StringPrint capture;
+  CaptureWriter writer(&capture);
+  Record(writer, 0, "ab", 1000);
+  Record(writer, 3, "c", 201000);
+  const uint8_t expected[] = {'N', 'C',  'A',  'P',  1, 0, 0, 2,
+                              'a', 'b', 0xC0, 0x9A, 0x0C, 3, 1, 'c'};
+  TEST_ASSERT_EQUAL_INT(sizeof(expected), capture.length());
+  TEST_ASSERT_EQUAL_INT(sizeof(expected), writer.get_size());
+  TEST_ASSERT_EQUAL_MEMORY(expected, capture.c_str(), sizeof(expected));
+
+  CaptureReader reader(reinterpret_cast<const uint8_t*>(capture.c_str()),
+                       capture.length());
+  CaptureRecord record;
+  TEST_ASSERT_TRUE(reader.ok());
+  TEST_ASSERT_TRUE(reader.next(&record));
+  TEST_ASSERT_TRUE(reader.next(&record));
+  TEST_ASSERT_EQUAL_UINT32(200000, record.delta_us);
+  TEST_ASSERT_EQUAL_UINT8(3, record.source);
+  TEST_ASSERT_EQUAL_INT(1, record.length);
+  TEST_ASSERT_FALSE(reader.next(&record));
+
+  // A truncated record is not returned
+  CaptureReader truncated(reinterpret_cast<const uint8_t*>(capture.c_str()),
+                          capture.length() - 1);
+  TEST_ASSERT_TRUE(truncated.next(&record));
+  TEST_ASSERT_FALSE(truncated.next(&record));
+}
+
+// At 1x, records arrive at their recorded times.
+void test_replay_in_real_time(void) {
+  size_t length;
+  const uint8_t* capture = MakeCapture(&length);
+  auto* replay = new CaptureReplayStream(capture, length);
+  auto* io = new NMEA0183IO(replay);
+  auto* hdt = new HDTSentenceParser(&io->parser_);
+  auto* hdm = new HDMSentenceParser(&io->parser_);
+
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(1, hdt->get_rx_count());
+  delay(99);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(0, hdm->get_rx_count());
+  delay(1);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(1, hdm->get_rx_count());
+  TEST_ASSERT_FALSE(replay->finished());
+  delay(400);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(2, hdt->get_rx_count());
+  TEST_ASSERT_TRUE(replay->finished());
+}
+
+// At 10x, and of one source only; at 0, as fast as it is read.
+void test_replay_speed_and_source(void) {
+  size_t length;
+  const uint8_t* capture = MakeCapture(&length);
+  auto* replay = new CaptureReplayStream(capture, length, 10, 0);
+  std::string read;
+  while (replay->available()) {
+    read += static_cast<char>(replay->read());
+  }
+  TEST_ASSERT_EQUAL_STRING(kHDT, read.c_str());
+  delay(49);
+  TEST_ASSERT_EQUAL_INT(0, replay->available());
+  delay(1);
+  TEST_ASSERT_EQUAL_INT(strlen(kHDT), replay->available());
+
+  auto* fast = new CaptureReplayStream(capture, length, 0);
+  read = "";
+  while (fast->available()) {
+    read += static_cast<char>(fast->read());
+  }
+  TEST_ASSERT_EQUAL_STRING((std::string(kHDT) + kHDM + kHDT).c_str(),
+                           read.c_str());
+  TEST_ASSERT_TRUE(fast->finished());
+}
+
+// What NMEA0183IO reads is captured as read.
+void test_io_capture_round_trip(void) {
+  size_t length;
+  const uint8_t* capture = MakeCapture(&length);
+  auto* replay = new CaptureReplayStream(capture, length, 0);
+  auto* io = new NMEA0183IO(replay);
+  auto* recapture = new StringPrint();
+  auto* writer = new CaptureWriter(recapture);
+  io->capture_to(writer, 7);
+  event_loop()->tick();
+
+  CaptureReader reader(reinterpret_cast<const uint8_t*>(recapture->c_str()),
+                       recapture->length());
+  CaptureRecord record;
+  std::string read;
+  while (reader.next(&record)) {
+    TEST_ASSERT_EQUAL_UINT8(7, record.source);
+    read.append(reinterpret_cast<const char*>(record.data), record.length);
+  }
+  TEST_ASSERT_EQUAL_STRING((std::string(kHDT) + kHDM + kHDT).c_str(),
+                           read.c_str());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_capture_format);
+  RUN_TEST(test_replay_in_real_time);
+  RUN_TEST(test_replay_speed_and_source);
+  RUN_TEST(test_io_capture_round_trip);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_capture_format);
+  RUN_TEST(test_replay_in_real_time);
+  RUN_TEST(test_replay_speed_and_source);
+  RUN_TEST(test_io_capture_round_trip);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,194 @@
+#include <unity.h>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/gnss_sentence_parser.h"
+#include "sensesp_nmea0183/transforms/gnss_epoch_assembler.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static NMEA0183Parser* parser;
+static GGASentenceParser* gga;
+static RMCSentenceParser* rmc;
+static GSASentenceParser* gsa;
+static VTGSentenceParser* vtg;
+static ZDASentenceParser* zda;
+static GNSSEpochAssembler* assembler;
+
+static int emit_count = 0;
+static GNSSFix last_fix;
+
+// Two epochs as emitted by a receiver reporting RMC, VTG, GGA and GSA
+static const char* kEpoch1[] = {
+    "$GNRMC,121042.00,A,6011.07385,N,02503.04396,E,0.087,,050222,,,D*64",
+    "$GNVTG,,T,,M,0.087,N,0.161,K,D*31",
+    "$GNGGA,121042.00,6011.07385,N,02503.04396,E,2,11,1.04,17.0,M,17.6,M,,"
+    "0000*75",
+    "$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*27",
+};
+static const char* kEpoch2[] = {
+    "$GNRMC,121043.00,A,6011.07400,N,02503.04400,E,0.100,,050222,,,D*69",
+    "$GNVTG,,T,,M,0.100,N,0.185,K,D*35",
+    "$GNGGA,121043.00,6011.07400,N,02503.04400,E,2,12,1.00,17.5,M,17.6,M,,"
+    "0000*74",
+    "$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.4,1.2,2.0*26",
+};
+
+void setUp(void) {
+  parser = new NMEA0183Parser();
+  gga = new GGASentenceParser(parser);
+  rmc = new RMCSentenceParser(parser);
+  gsa = new GSASentenceParser(parser);
+  vtg = new VTGSentenceParser(parser);
+  zda = new ZDASentenceParser(parser);
+  assembler = new GNSSEpochAssembler(gga, rmc, nullptr, gsa, vtg, zda);
+  emit_count = 0;
+  last_fix = GNSSFix();
+  assembler->attach([]() {
+    emit_count++;
+    last_fix = assembler->get();
+  });
+}
+
+void tearDown(void) {
+  delete assembler;
+  delete zda;
+  delete vtg;
+  delete gsa;
+  delete rmc;
+  delete gga;
+  delete parser;
+}
+
+// The first epoch is only known to be complete when the next one starts;
+// it must then be emitted once with the fields of all four sentences.
+void test_epoch_merges_sentences(void) {
+  for (const char* s : kEpoch1) parser->set(s);
+  TEST_ASSERT_EQUAL_INT(0, emit_count);
+
+  parser->set(kEpoch2[0]);
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 12 * 3600 + 10 * 60 + 42, last_fix.utc_time);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 60.1845, last_fix.position.latitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 25.0507, last_fix.position.longitude);
+  // Altitude from GGA survives the RMC position without one
+  TEST_ASSERT_FLOAT_WITHIN(0.1, 17.0, last_fix.position.altitude);
+  TEST_ASSERT_EQUAL_INT(2, last_fix.quality);
+  TEST_ASSERT_EQUAL_INT(11, last_fix.num_satellites);
+  TEST_ASSERT_EQUAL_INT(3, last_fix.fix_type);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 2.5, last_fix.pdop);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 0.087 * 1852.0 / 3600.0, last_fix.speed);
+  TEST_ASSERT_EQUAL_INT(GNSSEpochAssembler::kRMC | GNSSEpochAssembler::kVTG |
+                            GNSSEpochAssembler::kGGA |
+                            GNSSEpochAssembler::kGSA,
+                        last_fix.sources);
+}
+
+// Once the epoch composition is known, an epoch is emitted as soon as its
+// last sentence arrives.
+void test_epoch_emits_on_learned_composition(void) {
+  for (const char* s : kEpoch1) parser->set(s);
+  for (const char* s : kEpoch2) parser->set(s);
+
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  TEST_ASSERT_EQUAL_INT(12, last_fix.num_satellites);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 2.4, last_fix.pdop);
+}
+
+// A sentence arriving after its epoch was emitted is dropped, and the
+// following epochs wait for it.
+void test_epoch_learns_late_sentence(void) {
+  for (const char* s : kEpoch1) parser->set(s);
+  for (const char* s : kEpoch2) parser->set(s);
+  parser->set("$GNZDA,121043.00,05,02,2022,00,00*78");
+
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  TEST_ASSERT_EQUAL_INT(1, assembler->get_late_count());
+  TEST_ASSERT_TRUE(assembler->get_expected_sources() &
+                   GNSSEpochAssembler::kZDA);
+
+  parser->set(
+      "$GNRMC,121044.00,A,6011.07500,N,02503.04500,E,0.100,,050222,,,D*6E");
+  parser->set("$GNVTG,,T,,M,0.100,N,0.185,K,D*35");
+  parser->set(
+      "$GNGGA,121044.00,6011.07500,N,02503.04500,E,2,12,1.00,17.5,M,17.6,M,,"
+      "0000*73");
+  parser->set("$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.3,1.1,1.9*28");
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+
+  parser->set("$GNZDA,121044.00,05,02,2022,00,00*7F");
+  TEST_ASSERT_EQUAL_INT(3, emit_count);
+  TEST_ASSERT_TRUE(last_fix.sources & GNSSEpochAssembler::kZDA);
+}
+
+// A receiver reporting several GSAs per epoch, one per constellation. The
+// GSAs after the epoch is complete must not start an epoch of their own.
+void test_epoch_several_gsa(void) {
+  for (const char* s : kEpoch1) parser->set(s);
+  parser->set("$GNGSA,A,3,66,67,76,,,,,,,,,,2.5,1.3,2.1*2A");
+  for (const char* s : kEpoch2) parser->set(s);
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  parser->set("$GNGSA,A,3,66,67,76,,,,,,,,,,2.4,1.2,2.0*2B");
+
+  // No GSA-only fix on the timeout
+  delay(kGNSSEpochTimeout + 50);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  uint8_t expected = GNSSEpochAssembler::kRMC | GNSSEpochAssembler::kVTG |
+                     GNSSEpochAssembler::kGGA | GNSSEpochAssembler::kGSA;
+  TEST_ASSERT_EQUAL_INT(expected, assembler->get_expected_sources());
+
+  parser->set(
+      "$GNRMC,121044.00,A,6011.07500,N,02503.04500,E,0.100,,050222,,,D*6E");
+  parser->set("$GNVTG,,T,,M,0.100,N,0.185,K,D*35");
+  parser->set(
+      "$GNGGA,121044.00,6011.07500,N,02503.04500,E,2,12,1.00,17.5,M,17.6,M,,"
+      "0000*73");
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  parser->set("$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.3,1.1,1.9*28");
+  TEST_ASSERT_EQUAL_INT(3, emit_count);
+  TEST_ASSERT_EQUAL_INT(expected, last_fix.sources);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 2.3, last_fix.pdop);
+}
+
+// An assembler deleted with an epoch open leaves no timeout behind.
+void test_epoch_deleted_while_open(void) {
+  parser->set(kEpoch1[0]);
+  delete assembler;
+  assembler = new GNSSEpochAssembler(nullptr, nullptr, nullptr, nullptr,
+                                     nullptr, nullptr);
+  delay(kGNSSEpochTimeout + 50);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(0, emit_count);
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_epoch_merges_sentences);
+  RUN_TEST(test_epoch_emits_on_learned_composition);
+  RUN_TEST(test_epoch_learns_late_sentence);
+  RUN_TEST(test_epoch_several_gsa);
+  RUN_TEST(test_epoch_deleted_while_open);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_epoch_merges_sentences);
+  RUN_TEST(test_epoch_emits_on_learned_composition);
+  RUN_TEST(test_epoch_learns_late_sentence);
+  RUN_TEST(test_epoch_several_gsa);
+  RUN_TEST(test_epoch_deleted_while_open);
+
+  return UNITY_END();
+}
+#endif
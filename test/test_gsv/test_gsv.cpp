@@ -35,7 +35,7 @@ static const int kCycleLen = sizeof(kCycle) / sizeof(kCycle[0]);
 static const int kExpectedTotal = 47;
 
 static int emit_count = 0;
-static std::vector<GNSSSatellite> last_emitted;
+static GNSSSatelliteTable last_emitted;
 static int last_total_in_view = 0;
 
 static void feed_cycle() {
@@ -52,7 +52,7 @@ void setUp(void) {
   last_total_in_view = 0;
   gsv->satellites_.attach([]() {
     emit_count++;
-    last_emitted = gsv->satellites_.get();
+    last_emitted = *gsv->satellites_.get();
     last_total_in_view = gsv->total_svs_in_view_.get();
   });
 }
@@ -90,11 +90,105 @@ void test_gsv_one_merged_emit_per_cycle(void) {
   TEST_ASSERT_TRUE(gps && glonass && galileo && beidou);
 }
 
+// Satellites are stored in compact form; empty fields stay unreported.
+void test_gsv_compact_satellites(void) {
+  feed_cycle();
+  feed_cycle();
+
+  GNSSSatellite first = last_emitted[0];
+  TEST_ASSERT_EQUAL_INT((int)GNSSSystem::gps, (int)first.system);
+  TEST_ASSERT_EQUAL_INT(15, first.id);
+  TEST_ASSERT_EQUAL_INT(24, first.elevation);
+  TEST_ASSERT_EQUAL_INT(205, first.azimuth);
+  TEST_ASSERT_EQUAL_INT(43, first.snr);
+  TEST_ASSERT_EQUAL_STRING("GPS L1 C/A", first.signal());
+
+  // "13,,,41" in the third GPS L1 sentence
+  GNSSSatellite no_position = last_emitted[9];
+  TEST_ASSERT_EQUAL_INT(13, no_position.id);
+  TEST_ASSERT_EQUAL_INT(kGNSSSatelliteNoElevation, no_position.elevation);
+  TEST_ASSERT_EQUAL_INT(kGNSSSatelliteNoAzimuth, no_position.azimuth);
+  TEST_ASSERT_EQUAL_INT(41, no_position.snr);
+}
+
+// Once the composition is learned, a cycle is emitted at its last sentence
+// rather than at the start of the next cycle.
+void test_gsv_learned_cycle_emits_at_last_sentence(void) {
+  for (int i = 0; i < kGSVLearnCycles + 1; i++) {
+    feed_cycle();
+  }
+  TEST_ASSERT_TRUE(gsv->composition_learned());
+
+  int emits_before = emit_count;
+  for (int i = 0; i < kCycleLen - 1; i++) {
+    parser->set(kCycle[i]);
+  }
+  TEST_ASSERT_EQUAL_INT(emits_before, emit_count);
+  parser->set(kCycle[kCycleLen - 1]);
+  TEST_ASSERT_EQUAL_INT(emits_before + 1, emit_count);
+  TEST_ASSERT_EQUAL_INT(kExpectedTotal, (int)last_emitted.size());
+
+  // The next cycle starts from empty
+  feed_cycle();
+  TEST_ASSERT_EQUAL_INT(emits_before + 2, emit_count);
+  TEST_ASSERT_EQUAL_INT(kExpectedTotal, (int)last_emitted.size());
+}
+
+// A cycle without the last group is emitted by the wrap fallback.
+void test_gsv_changed_mix_falls_back_to_wrap(void) {
+  for (int i = 0; i < kGSVLearnCycles + 1; i++) {
+    feed_cycle();
+  }
+  TEST_ASSERT_TRUE(gsv->composition_learned());
+
+  // Galileo drops out
+  int emits_before = emit_count;
+  for (int i = 0; i < kCycleLen - 2; i++) {
+    parser->set(kCycle[i]);
+  }
+  TEST_ASSERT_EQUAL_INT(emits_before, emit_count);
+
+  parser->set(kCycle[0]);
+  TEST_ASSERT_EQUAL_INT(emits_before + 1, emit_count);
+  TEST_ASSERT_EQUAL_INT(kExpectedTotal - 8, (int)last_emitted.size());
+  TEST_ASSERT_FALSE(gsv->composition_learned());
+}
+
+// A group outside the learned composition arriving after the early
+// emission is dropped rather than carried into the next cycle.
+void test_gsv_late_group_dropped(void) {
+  for (int i = 0; i < kGSVLearnCycles + 1; i++) {
+    feed_cycle();
+  }
+  TEST_ASSERT_TRUE(gsv->composition_learned());
+
+  int emits_before = emit_count;
+  feed_cycle();
+  TEST_ASSERT_EQUAL_INT(emits_before + 1, emit_count);
+  // An intermittent Galileo signal reported after the last learned group
+  parser->set(
+      "$GAGSV,2,1,05,09,16,182,17,26,21,036,28,31,50,080,41,33,17,088,28,7*78");
+  parser->set("$GAGSV,2,2,05,03,35,305,31,7*47");
+  TEST_ASSERT_EQUAL_UINT32(1, gsv->get_late_group_count());
+  TEST_ASSERT_FALSE(gsv->composition_learned());
+
+  // The next cycle is emitted at the wrap, without the late satellites
+  feed_cycle();
+  parser->set(kCycle[0]);
+  TEST_ASSERT_EQUAL_INT(emits_before + 2, emit_count);
+  TEST_ASSERT_EQUAL_INT(kExpectedTotal, (int)last_emitted.size());
+  TEST_ASSERT_EQUAL_INT(0, gsv->get_dropped_count());
+}
+
 #ifdef ARDUINO
 void setup() {
   delay(2000);
   UNITY_BEGIN();
   RUN_TEST(test_gsv_one_merged_emit_per_cycle);
+  RUN_TEST(test_gsv_compact_satellites);
+  RUN_TEST(test_gsv_learned_cycle_emits_at_last_sentence);
+  RUN_TEST(test_gsv_changed_mix_falls_back_to_wrap);
+  RUN_TEST(test_gsv_late_group_dropped);
   UNITY_END();
 }
 
@@ -103,6 +197,10 @@ void loop() {}
 int main(int argc, char** argv) {
   UNITY_BEGIN();
   RUN_TEST(test_gsv_one_merged_emit_per_cycle);
+  RUN_TEST(test_gsv_compact_satellites);
+  RUN_TEST(test_gsv_learned_cycle_emits_at_last_sentence);
+  RUN_TEST(test_gsv_changed_mix_falls_back_to_wrap);
+  RUN_TEST(test_gsv_late_group_dropped);
   return UNITY_END();
 }
 #endif
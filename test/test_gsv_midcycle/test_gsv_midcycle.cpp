@@ -11,7 +11,7 @@ using namespace sensesp::nmea0183;
 static NMEA0183Parser* parser;
 static GSVSentenceParser* gsv;
 static int emit_count = 0;
-static std::vector<GNSSSatellite> last_emitted;
+static GNSSSatelliteTable last_emitted;
 
 // An intermittent Galileo signal (signal id 7) group -- a real receiver reports
 // it only in some cycles as those satellites come and go.
@@ -55,7 +55,7 @@ void setUp(void) {
   last_emitted.clear();
   gsv->satellites_.attach([]() {
     emit_count++;
-    last_emitted = gsv->satellites_.get();
+    last_emitted = *gsv->satellites_.get();
   });
 }
 
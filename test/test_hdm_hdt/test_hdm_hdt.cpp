@@ -48,6 +48,46 @@ void test_hdm_270_degrees(void) {
                            hdm->magnetic_heading_.get());
 }
 
+// Changes below the deadband are suppressed until max silence has passed.
+void test_hdt_deadband(void) {
+  DeadbandSettings settings;
+  settings.deadband = 0.1 * DEG_TO_RAD;
+  settings.max_silence_ms = 1000;
+  hdt->true_heading_.set_settings(settings);
+  int emit_count = 0;
+  hdt->true_heading_.attach([&emit_count]() { emit_count++; });
+
+  parser->set("$HCHDT,98.3,T*1B");
+  parser->set("$HCHDT,98.35,T*2E");
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 98.3 * DEG_TO_RAD,
+                           hdt->true_heading_.get());
+
+  parser->set("$HCHDT,98.5,T*1D");
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+
+  delay(1000);
+  parser->set("$HCHDT,98.5,T*1D");
+  TEST_ASSERT_EQUAL_INT(3, emit_count);
+  TEST_ASSERT_EQUAL_INT(1, hdt->true_heading_.get_suppressed_count());
+}
+
+// Heading is rounded to the quantum and compared across north.
+void test_hdt_quantization(void) {
+  DeadbandSettings settings;
+  settings.quantum = 0.1 * DEG_TO_RAD;
+  settings.deadband = 0.1 * DEG_TO_RAD;
+  hdt->true_heading_.set_settings(settings);
+  int emit_count = 0;
+  hdt->true_heading_.attach([&emit_count]() { emit_count++; });
+
+  // Rounds up to 360°, which is output as 0
+  parser->set("$HCHDT,359.95,T*1A");
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 0, hdt->true_heading_.get());
+  parser->set("$HCHDT,0.02,T*1B");
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+}
+
 #ifdef ARDUINO
 void setup() {
   delay(2000);
@@ -56,6 +96,8 @@ void setup() {
   RUN_TEST(test_hdm_valid_sentence);
   RUN_TEST(test_hdt_valid_sentence);
   RUN_TEST(test_hdm_270_degrees);
+  RUN_TEST(test_hdt_deadband);
+  RUN_TEST(test_hdt_quantization);
 
   UNITY_END();
 }
@@ -68,6 +110,8 @@ int main(int argc, char** argv) {
   RUN_TEST(test_hdm_valid_sentence);
   RUN_TEST(test_hdt_valid_sentence);
   RUN_TEST(test_hdm_270_degrees);
+  RUN_TEST(test_hdt_deadband);
+  RUN_TEST(test_hdt_quantization);
 
   return UNITY_END();
 }
@@ -0,0 +1,118 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/gnss_sentence_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static const char* kGGA =
+    "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+static const char* kRMC =
+    "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+
+static NMEA0183Parser* parser;
+static GGASentenceParser* gga;
+static RMCSentenceParser* rmc;
+
+void setUp(void) {
+  parser = new NMEA0183Parser();
+  parser->set_lazy(true);
+  gga = new GGASentenceParser(parser);
+  rmc = new RMCSentenceParser(parser);
+}
+
+void tearDown(void) {
+  delete rmc;
+  delete gga;
+  delete parser;
+}
+
+void test_lazy_parses_observed_outputs_only(void) {
+  int updates = 0;
+  gga->position_.attach([&updates]() { updates++; });
+  parser->set(kGGA);
+
+  TEST_ASSERT_EQUAL_INT(1, gga->get_rx_count());
+  TEST_ASSERT_EQUAL_INT(1, updates);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 48.1173, gga->position_.get().latitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.1, 545.4, gga->position_.get().altitude);
+  // Not observed, so neither parsed nor set
+  TEST_ASSERT_EQUAL_INT(0, gga->num_satellites_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 0.0, gga->utc_time_.get());
+}
+
+void test_lazy_unobserved_parser_skipped(void) {
+  gga->position_.attach([]() {});
+  parser->set(kRMC);
+  TEST_ASSERT_EQUAL_INT(0, rmc->get_rx_count());
+  TEST_ASSERT_FALSE(rmc->wanted());
+
+  rmc->speed_.attach([]() {});
+  parser->set(kRMC);
+  TEST_ASSERT_EQUAL_INT(1, rmc->get_rx_count());
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 22.4 * 1852. / 3600., rmc->speed_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 0.0, rmc->true_course_.get());
+}
+
+void test_lazy_address_filter(void) {
+  // Sentences of unobserved lazy parsers aren't read at all
+  gga->position_.attach([]() {});
+  TEST_ASSERT_TRUE(parser->accepts_address("GPGGA", 5));
+  TEST_ASSERT_FALSE(parser->accepts_address("GPRMC", 5));
+
+  // Observing an output updates the filter
+  rmc->speed_.attach([]() {});
+  TEST_ASSERT_TRUE(parser->accepts_address("GPRMC", 5));
+}
+
+void test_lazy_parser_observer(void) {
+  // An observer of the parser keeps it dispatched, and outputs it reads
+  // with get() are marked explicitly
+  float utc_time = 0;
+  gga->utc_time_.set_observed();
+  gga->attach([&utc_time]() { utc_time = gga->utc_time_.get(); });
+  parser->set(kGGA);
+
+  TEST_ASSERT_EQUAL_INT(1, gga->get_rx_count());
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 12 * 3600 + 35 * 60 + 19, utc_time);
+  TEST_ASSERT_EQUAL_INT(0, gga->num_satellites_.get());
+}
+
+void test_not_lazy_parses_everything(void) {
+  parser->set_lazy(false);
+  parser->set(kRMC);
+
+  TEST_ASSERT_EQUAL_INT(1, rmc->get_rx_count());
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 22.4 * 1852. / 3600., rmc->speed_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 84.4 * DEG_TO_RAD, rmc->true_course_.get());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_lazy_parses_observed_outputs_only);
+  RUN_TEST(test_lazy_unobserved_parser_skipped);
+  RUN_TEST(test_lazy_address_filter);
+  RUN_TEST(test_lazy_parser_observer);
+  RUN_TEST(test_not_lazy_parses_everything);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_lazy_parses_observed_outputs_only);
+  RUN_TEST(test_lazy_unobserved_parser_skipped);
+  RUN_TEST(test_lazy_address_filter);
+  RUN_TEST(test_lazy_parser_observer);
+  RUN_TEST(test_not_lazy_parses_everything);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,135 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/boot_report.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/transforms/lazy_sk_output.h"
+#include "sensesp_nmea0183/transforms/output_policy.h"
+#include "sensesp_nmea0183/wiring.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+void setUp(void) {
+  LazySKOutputBase::set_lazy(true);
+  LazySKOutputBase::materialize_all();
+  BootReport::clear();
+}
+
+void tearDown(void) { LazySKOutputBase::set_lazy(false); }
+
+void test_eager_by_default(void) {
+  LazySKOutputBase::set_lazy(false);
+  auto* output = new LazySKOutputFloat("navigation.headingTrue", "");
+  TEST_ASSERT_TRUE(output->is_materialized());
+  TEST_ASSERT_EQUAL_UINT32(0, LazySKOutputBase::get_pending_count());
+  TEST_ASSERT_EQUAL_UINT32(
+      1, BootReport::get_phase_count("Create Signal K outputs"));
+}
+
+void test_created_on_first_value(void) {
+  auto* output = new LazySKOutputFloat("environment.depth.belowTransducer",
+                                       "/SK Path/Depth");
+  float forwarded = 0;
+  output->attach([&]() { forwarded = output->get(); });
+  TEST_ASSERT_FALSE(output->is_materialized());
+  TEST_ASSERT_EQUAL_UINT32(1, LazySKOutputBase::get_pending_count());
+  TEST_ASSERT_EQUAL_STRING("environment.depth.belowTransducer",
+                           output->get_sk_path().c_str());
+
+  delay(10);
+  output->set(4.5);
+  TEST_ASSERT_TRUE(output->is_materialized());
+  TEST_ASSERT_TRUE(BootReport::get_event_us("First Signal K value") > 0);
+  TEST_ASSERT_EQUAL_UINT32(0, LazySKOutputBase::get_pending_count());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 4.5, output->get_output()->get());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 4.5, forwarded);
+  TEST_ASSERT_EQUAL_STRING("environment.depth.belowTransducer",
+                           output->get_sk_path().c_str());
+}
+
+void test_output_policy_keeps_output_pending(void) {
+  OutputPolicies policies = {
+      {"navigation.speedOverGround", {OutputPolicyMode::max_rate, 1000}}};
+  auto* sog = new LazySKOutputFloat("navigation.speedOverGround", "");
+  auto* cog = new LazySKOutputFloat("navigation.courseOverGroundTrue", "");
+
+  TEST_ASSERT_TRUE(WithOutputPolicy(sog, policies) != sog);
+  TEST_ASSERT_TRUE(WithOutputPolicy(cog, policies) == cog);
+  TEST_ASSERT_EQUAL_UINT32(2, LazySKOutputBase::get_pending_count());
+
+  LazySKOutputBase::materialize_all();
+  TEST_ASSERT_TRUE(sog->is_materialized());
+  TEST_ASSERT_TRUE(cog->is_materialized());
+}
+
+// Outputs of the same path keep separate policy configurations.
+void test_output_policy_config_path(void) {
+  OutputPolicies policies = {
+      {"environment.water.temperature", {OutputPolicyMode::average, 1000}}};
+  auto* mtw = new LazySKOutputFloat("environment.water.temperature",
+                                    "/SK Path/Water Temperature");
+  auto* mda = new LazySKOutputFloat("environment.water.temperature",
+                                    "/SK Path/MDA Water Temperature");
+
+  auto* mtw_policy = static_cast<OutputPolicyTransform<float>*>(
+      WithOutputPolicy(mtw, policies));
+  auto* mda_policy = static_cast<OutputPolicyTransform<float>*>(
+      WithOutputPolicy(mda, policies));
+  TEST_ASSERT_EQUAL_STRING("/SK Path/Water Temperature/Output Policy",
+                           mtw_policy->get_config_path().c_str());
+  TEST_ASSERT_EQUAL_STRING("/SK Path/MDA Water Temperature/Output Policy",
+                           mda_policy->get_config_path().c_str());
+}
+
+void test_boot_report(void) {
+  auto* parser = new NMEA0183Parser();
+  auto* data = new HeadingData();
+  ConnectHeading(parser, data);
+
+  TEST_ASSERT_EQUAL_UINT32(1, BootReport::get_phase_count("ConnectHeading"));
+  TEST_ASSERT_EQUAL_UINT32(
+      0, BootReport::get_phase_count("Create Signal K outputs"));
+  TEST_ASSERT_EQUAL_UINT32(2, LazySKOutputBase::get_pending_count());
+
+  delay(25);
+  parser->set("$HCHDT,98.3,T*1B");
+  TEST_ASSERT_TRUE(BootReport::get_event_us("First sentence parsed") > 0);
+  TEST_ASSERT_EQUAL_UINT32(
+      1, BootReport::get_phase_count("Create Signal K outputs"));
+  TEST_ASSERT_EQUAL_UINT32(1, LazySKOutputBase::get_pending_count());
+
+  // Phases with the same name are summed
+  BootReport::add_phase("Test", 10);
+  BootReport::add_phase("Test", 15);
+  TEST_ASSERT_EQUAL_UINT32(25, BootReport::get_phase_us("Test"));
+  TEST_ASSERT_EQUAL_UINT32(2, BootReport::get_phase_count("Test"));
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_eager_by_default);
+  RUN_TEST(test_created_on_first_value);
+  RUN_TEST(test_output_policy_keeps_output_pending);
+  RUN_TEST(test_output_policy_config_path);
+  RUN_TEST(test_boot_report);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_eager_by_default);
+  RUN_TEST(test_created_on_first_value);
+  RUN_TEST(test_output_policy_keeps_output_pending);
+  RUN_TEST(test_output_policy_config_path);
+  RUN_TEST(test_boot_report);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,139 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/io/linux_serial_ports.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/navigation_sentence_parser.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#endif
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+#ifdef __linux__
+/// Open a pty master and return it with the path of its slave
+static int OpenPty(const char** slave_path) {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  grantpt(master);
+  unlockpt(master);
+  *slave_path = ptsname(master);
+  return master;
+}
+
+static void Write(int fd, const char* data) { write(fd, data, strlen(data)); }
+
+/// Read until port has read bytes bytes. A pty passes data on to its slave
+/// asynchronously, so one run_once() may see only part of it. Returns the
+/// number of ports read.
+static int RunUntilRead(NMEA0183SerialPorts& ports, int port,
+                        unsigned long bytes) {
+  int ports_read = 0;
+  for (int i = 0; i < 100 && ports.get_stats(port).bytes < bytes; i++) {
+    ports_read += ports.run_once(10);
+  }
+  return ports_read;
+}
+
+// Each port has its own framer and counters, and all feed one parser.
+void test_ports_feed_one_parser(void) {
+  NMEA0183Parser parser;
+  HDTSentenceParser hdt(&parser);
+  HDMSentenceParser hdm(&parser);
+  NMEA0183SerialPorts ports(&parser);
+
+  const char* path;
+  int first = OpenPty(&path);
+  TEST_ASSERT_EQUAL_INT(0, ports.open_port(path, 4800));
+  int second = OpenPty(&path);
+  TEST_ASSERT_EQUAL_INT(1, ports.open_port(path, 38400));
+
+  // Nothing to read: returns at the timeout
+  TEST_ASSERT_EQUAL_INT(0, ports.run_once(0));
+
+  // The first sentence is split between two writes
+  Write(first, "$HCHDT,98.");
+  Write(second, "$HCHDM,101.1,M*28\r\n$GPGSV,1,1,01,15,24,205,43*4A\r\n");
+  RunUntilRead(ports, 0, 10);
+  RunUntilRead(ports, 1, 50);
+  Write(first, "3,T*1B\r\n");
+  TEST_ASSERT_GREATER_THAN_INT(0, RunUntilRead(ports, 0, 18));
+
+  TEST_ASSERT_EQUAL_INT(1, hdt.get_rx_count());
+  TEST_ASSERT_EQUAL_INT(1, hdm.get_rx_count());
+  const SerialPortStats& first_stats = ports.get_stats(0);
+  const SerialPortStats& second_stats = ports.get_stats(1);
+  TEST_ASSERT_EQUAL_UINT32(18, first_stats.bytes);
+  TEST_ASSERT_EQUAL_UINT32(2, first_stats.reads);
+  TEST_ASSERT_EQUAL_UINT32(1, first_stats.sentences);
+  TEST_ASSERT_EQUAL_UINT32(1, second_stats.sentences);
+  TEST_ASSERT_EQUAL_UINT32(1, second_stats.rejected);
+
+  close(first);
+  close(second);
+}
+
+// run() returns on stop() or when every port has hung up. A stop() before
+// run() is forgotten.
+void test_run_until_hangup_or_stop(void) {
+  NMEA0183Parser parser;
+  HDTSentenceParser hdt(&parser);
+  NMEA0183SerialPorts ports(&parser);
+  const char* path;
+  int master = OpenPty(&path);
+  ports.open_port(path);
+
+  ports.stop();
+  std::atomic<bool> stopping{false};
+  std::thread stopper([&]() {
+    usleep(20000);
+    stopping = true;
+    ports.stop();
+  });
+  ports.run();
+  stopper.join();
+  TEST_ASSERT_TRUE(stopping);
+  TEST_ASSERT_TRUE(ports.get_stats(0).open);
+
+  Write(master, "$HCHDT,98.3,T*1B\r\n");
+  // Let the sentence arrive before hanging up
+  RunUntilRead(ports, 0, 18);
+  close(master);
+  ports.run();
+  TEST_ASSERT_FALSE(ports.get_stats(0).open);
+  TEST_ASSERT_EQUAL_INT(1, hdt.get_rx_count());
+}
+#endif
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  // NMEA0183SerialPorts is available on Linux only
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+#ifdef __linux__
+  RUN_TEST(test_ports_feed_one_parser);
+  RUN_TEST(test_run_until_hangup_or_stop);
+#endif
+
+  return UNITY_END();
+}
+#endif
@@ -48,6 +48,24 @@ void test_mda_pressure_only(void) {
   TEST_ASSERT_EQUAL_INT(1, mda->get_rx_count());
 }
 
+// In batching mode, each observer sees all outputs of the sentence updated.
+void test_mda_batching(void) {
+  mda->set_batching(true);
+  float speed_seen = 0;
+  int sentence_count = 0;
+  mda->true_wind_direction_.attach(
+      [&speed_seen]() { speed_seen = mda->true_wind_speed_.get(); });
+  mda->attach([&sentence_count]() { sentence_count++; });
+
+  parser->set(
+      "$WIMDA,29.7544,I,1.0076,B,16.1,C,,,42.6,,11.2,C,225.0,T,220.0,M,"
+      "12.5,N,6.4,M*55");
+
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 6.4, speed_seen);
+  TEST_ASSERT_EQUAL_INT(1, sentence_count);
+  TEST_ASSERT_FLOAT_WITHIN(1.0, 100760.0, mda->barometric_pressure_.get());
+}
+
 #ifdef ARDUINO
 void setup() {
   delay(2000);
@@ -55,6 +73,7 @@ void setup() {
 
   RUN_TEST(test_mda_full_sentence);
   RUN_TEST(test_mda_pressure_only);
+  RUN_TEST(test_mda_batching);
 
   UNITY_END();
 }
@@ -66,6 +85,7 @@ int main(int argc, char** argv) {
 
   RUN_TEST(test_mda_full_sentence);
   RUN_TEST(test_mda_pressure_only);
+  RUN_TEST(test_mda_batching);
 
   return UNITY_END();
 }
@@ -115,6 +115,40 @@ void test_mwv_true_wind_knots(void) {
   TEST_ASSERT_FLOAT_WITHIN(0.01, 7.7167, mwv_true->true_wind_speed_.get());
 }
 
+/// MWV parser that counts the sentences it is given and parses none
+class CountingMWVParser : public SentenceParser {
+ public:
+  CountingMWVParser(NMEA0183Parser* nmea, const char* reference)
+      : SentenceParser(nmea), reference_{reference} {}
+  bool parse_fields(const char* field_strings, const int field_offsets[],
+                    int num_fields) override {
+    calls++;
+    return false;
+  }
+  const char* sentence_address() override { return "..MWV"; }
+  SentenceDiscriminator discriminator() override { return {2, reference_}; }
+
+  int calls = 0;
+
+ private:
+  const char* reference_;
+};
+
+void test_mwv_dispatch_by_reference(void) {
+  NMEA0183Parser dispatcher;
+  CountingMWVParser relative(&dispatcher, "R");
+  CountingMWVParser true_wind(&dispatcher, "T");
+
+  // A failed parse is not retried with the other reference's parser
+  dispatcher.set("$IIMWV,045.0,R,12.5,N,A*0A");
+  TEST_ASSERT_EQUAL_INT(1, relative.calls);
+  TEST_ASSERT_EQUAL_INT(0, true_wind.calls);
+
+  dispatcher.set("$IIMWV,225.0,T,6.4,M,A*3F");
+  TEST_ASSERT_EQUAL_INT(1, relative.calls);
+  TEST_ASSERT_EQUAL_INT(1, true_wind.calls);
+}
+
 #ifdef ARDUINO
 void setup() {
   delay(2000);
@@ -129,6 +163,7 @@ void setup() {
   RUN_TEST(test_mwv_true_wind);
   RUN_TEST(test_mwv_true_rejects_apparent_wind);
   RUN_TEST(test_mwv_true_wind_knots);
+  RUN_TEST(test_mwv_dispatch_by_reference);
 
   UNITY_END();
 }
@@ -147,6 +182,7 @@ int main(int argc, char** argv) {
   RUN_TEST(test_mwv_true_wind);
   RUN_TEST(test_mwv_true_rejects_apparent_wind);
   RUN_TEST(test_mwv_true_wind_knots);
+  RUN_TEST(test_mwv_dispatch_by_reference);
 
   return UNITY_END();
 }
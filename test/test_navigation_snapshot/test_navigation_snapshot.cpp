@@ -0,0 +1,134 @@
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+
+#include "sensesp_nmea0183/data/navigation_snapshot.h"
+#include "sensesp_nmea0183/wiring.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static NavigationSnapshot* snapshot;
+static GNSSData* location_data;
+static HeadingData* heading_data;
+static ApparentWindData* apparent_wind_data;
+
+void setUp(void) {
+  snapshot = new NavigationSnapshot();
+  location_data = new GNSSData();
+  heading_data = new HeadingData();
+  apparent_wind_data = new ApparentWindData();
+  ConnectNavigationSnapshot(snapshot, location_data, heading_data,
+                            apparent_wind_data);
+}
+
+void tearDown(void) {
+  delete apparent_wind_data;
+  delete heading_data;
+  delete location_data;
+  delete snapshot;
+}
+
+void test_snapshot_values_and_age(void) {
+  NavigationState state;
+  TEST_ASSERT_TRUE(snapshot->read(&state));
+  TEST_ASSERT_FALSE(state.heading_true.valid);
+
+  heading_data->true_heading.set(1.5);
+  uint32_t updated = millis();
+  delay(50);
+
+  TEST_ASSERT_TRUE(snapshot->read(&state));
+  TEST_ASSERT_TRUE(state.heading_true.valid);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 1.5, state.heading_true.value);
+  TEST_ASSERT_EQUAL_UINT32(updated, state.heading_true.updated_ms);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(50, state.heading_true.age_ms(millis()));
+  TEST_ASSERT_FALSE(state.heading_magnetic.valid);
+  TEST_ASSERT_EQUAL_UINT32(1, state.version);
+}
+
+// A GNSS fix is written as a single update.
+void test_snapshot_gnss_fix(void) {
+  GNSSFix fix;
+  fix.position.latitude = 60.1845;
+  fix.position.longitude = 25.0507;
+  fix.speed = 2.5;
+  location_data->fix.set(fix);
+
+  NavigationState state;
+  TEST_ASSERT_TRUE(snapshot->read(&state));
+  TEST_ASSERT_EQUAL_UINT32(1, state.version);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 60.1845, state.position.value.latitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 2.5, state.speed_over_ground.value);
+  TEST_ASSERT_FALSE(state.course_over_ground_true.valid);
+}
+
+// A reader on another thread never sees a half-written update.
+void test_snapshot_concurrent_reader(void) {
+  constexpr int kMinWrites = 100000;
+  constexpr int kMinReads = 1000;
+  std::atomic<bool> started{false};
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::atomic<int> reads{0};
+
+  std::thread reader([&]() {
+    NavigationState state;
+    started = true;
+    while (!done) {
+      if (snapshot->read(&state)) {
+        if (state.apparent_wind_angle.value !=
+            state.apparent_wind_speed.value) {
+          torn++;
+        }
+        reads++;
+      }
+    }
+  });
+
+  while (!started) {
+    std::this_thread::yield();
+  }
+  // Keep writing until the reader has had kMinReads reads during the
+  // writes, however the threads get scheduled
+  for (int i = 0; i < kMinWrites || reads < kMinReads; i++) {
+    snapshot->write([i](NavigationState* state) {
+      state->apparent_wind_angle.set(i, i);
+      state->apparent_wind_speed.set(i, i);
+    });
+    if (i >= kMinWrites) {
+      std::this_thread::yield();
+    }
+  }
+  done = true;
+  reader.join();
+
+  TEST_ASSERT_EQUAL_INT(0, torn.load());
+  TEST_ASSERT_GREATER_OR_EQUAL_INT(kMinReads, reads.load());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_snapshot_values_and_age);
+  RUN_TEST(test_snapshot_gnss_fix);
+  RUN_TEST(test_snapshot_concurrent_reader);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_snapshot_values_and_age);
+  RUN_TEST(test_snapshot_gnss_fix);
+  RUN_TEST(test_snapshot_concurrent_reader);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,217 @@
+#include <unity.h>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/transforms/output_policy.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static OutputPolicyTransform<float>* transform;
+static int emit_count = 0;
+static float last_value = 0;
+
+static OutputPolicy MakePolicy(OutputPolicyMode mode,
+                               unsigned int interval_ms) {
+  OutputPolicy policy;
+  policy.mode = mode;
+  policy.interval_ms = interval_ms;
+  return policy;
+}
+
+void setUp(void) {
+  transform = new OutputPolicyTransform<float>();
+  emit_count = 0;
+  last_value = 0;
+  transform->attach([]() {
+    emit_count++;
+    last_value = transform->get();
+  });
+}
+
+void tearDown(void) { delete transform; }
+
+void test_passthrough(void) {
+  transform->set(1.0);
+  transform->set(2.0);
+  transform->set(3.0);
+  TEST_ASSERT_EQUAL_INT(3, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 3.0, last_value);
+}
+
+// Values arriving within the interval of the previous output are dropped.
+void test_max_rate(void) {
+  transform->set_policy(MakePolicy(OutputPolicyMode::max_rate, 100));
+  transform->set(1.0);
+  transform->set(2.0);
+  transform->set(3.0);
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 1.0, last_value);
+  TEST_ASSERT_EQUAL_INT(2, transform->get_suppressed_count());
+
+  delay(110);
+  transform->set(4.0);
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 4.0, last_value);
+}
+
+// The latest value of an interval is output when the interval ends.
+void test_decimate(void) {
+  transform->set_policy(MakePolicy(OutputPolicyMode::decimate, 100));
+  transform->set(1.0);
+  transform->set(2.0);
+  transform->set(3.0);
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+
+  delay(110);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 3.0, last_value);
+}
+
+// Changing the policy drops the value pending under the previous one.
+void test_policy_change_cancels_flush(void) {
+  transform->set_policy(MakePolicy(OutputPolicyMode::average, 100));
+  transform->set(1.0);
+  transform->set_policy(MakePolicy(OutputPolicyMode::decimate, 200));
+  transform->set(2.0);
+  transform->set(3.0);
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+
+  delay(110);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 2.0, last_value);
+
+  delay(100);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(2, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 3.0, last_value);
+}
+
+void test_average(void) {
+  transform->set_policy(MakePolicy(OutputPolicyMode::average, 100));
+  transform->set(1.0);
+  transform->set(2.0);
+  transform->set(6.0);
+  TEST_ASSERT_EQUAL_INT(0, emit_count);
+
+  delay(110);
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 3.0, last_value);
+}
+
+// Angles are averaged as directions, across north as well.
+void test_average_angles(void) {
+  auto* angles = new OutputPolicyTransform<float>(
+      MakePolicy(OutputPolicyMode::average, 100), "", true);
+  angles->set(350 * DEG_TO_RAD);
+  angles->set(10 * DEG_TO_RAD);
+  delay(110);
+  event_loop()->tick();
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 0, angles->get());
+
+  // Signed angles stay signed
+  angles->set(-10 * DEG_TO_RAD);
+  angles->set(-30 * DEG_TO_RAD);
+  delay(110);
+  event_loop()->tick();
+  TEST_ASSERT_FLOAT_WITHIN(0.001, -20 * DEG_TO_RAD, angles->get());
+
+  angles->set(170 * DEG_TO_RAD);
+  angles->set(210 * DEG_TO_RAD);
+  delay(110);
+  event_loop()->tick();
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 190 * DEG_TO_RAD, angles->get());
+  delete angles;
+}
+
+// The wiring helpers average angles only for outputs marked angular.
+void test_angular_output(void) {
+  OutputPolicies policies;
+  policies["navigation.headingTrue"] =
+      MakePolicy(OutputPolicyMode::average, 100);
+  for (bool angular : {true, false}) {
+    ObservableValue<float> output;
+    auto* input = WithOutputPolicy<float>(&output, "navigation.headingTrue",
+                                          "", policies, angular);
+    input->set(350 * DEG_TO_RAD);
+    input->set(10 * DEG_TO_RAD);
+    delay(110);
+    event_loop()->tick();
+    TEST_ASSERT_FLOAT_WITHIN(0.001, angular ? 0 : 180 * DEG_TO_RAD,
+                             output.get());
+    delete static_cast<OutputPolicyTransform<float>*>(input);
+  }
+}
+
+// A mode outside OutputPolicyMode in the configuration is rejected.
+void test_unknown_mode_rejected(void) {
+  transform->set_policy(MakePolicy(OutputPolicyMode::max_rate, 100));
+  JsonDocument doc;
+  JsonObject config = doc.to<JsonObject>();
+  config["mode"] = 7;
+  config["interval"] = 500;
+  TEST_ASSERT_FALSE(transform->from_json(config));
+  TEST_ASSERT_EQUAL_INT((int)OutputPolicyMode::max_rate,
+                        (int)transform->get_policy().mode);
+  TEST_ASSERT_EQUAL_INT(100, transform->get_policy().interval_ms);
+
+  config["mode"] = (int)OutputPolicyMode::decimate;
+  TEST_ASSERT_TRUE(transform->from_json(config));
+  TEST_ASSERT_EQUAL_INT(500, transform->get_policy().interval_ms);
+}
+
+void test_policy_lookup(void) {
+  OutputPolicies policies;
+  policies["*"] = MakePolicy(OutputPolicyMode::max_rate, 1000);
+  policies["navigation.position"] =
+      MakePolicy(OutputPolicyMode::average, 500);
+
+  OutputPolicy policy;
+  TEST_ASSERT_TRUE(
+      FindOutputPolicy(policies, "navigation.position", &policy));
+  TEST_ASSERT_EQUAL_INT((int)OutputPolicyMode::average, (int)policy.mode);
+  TEST_ASSERT_TRUE(FindOutputPolicy(policies, "navigation.headingTrue",
+                                    &policy));
+  TEST_ASSERT_EQUAL_INT(1000, policy.interval_ms);
+  TEST_ASSERT_FALSE(
+      FindOutputPolicy(OutputPolicies(), "navigation.position", &policy));
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_passthrough);
+  RUN_TEST(test_max_rate);
+  RUN_TEST(test_decimate);
+  RUN_TEST(test_policy_change_cancels_flush);
+  RUN_TEST(test_average);
+  RUN_TEST(test_average_angles);
+  RUN_TEST(test_angular_output);
+  RUN_TEST(test_unknown_mode_rejected);
+  RUN_TEST(test_policy_lookup);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_passthrough);
+  RUN_TEST(test_max_rate);
+  RUN_TEST(test_decimate);
+  RUN_TEST(test_policy_change_cancels_flush);
+  RUN_TEST(test_average);
+  RUN_TEST(test_average_angles);
+  RUN_TEST(test_angular_output);
+  RUN_TEST(test_unknown_mode_rejected);
+  RUN_TEST(test_policy_lookup);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,179 @@
+#include <unity.h>
+
+#include <string>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/io/output_queue.h"
+#include "sensesp_nmea0183/nmea0183.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+/// Stream that takes a limited number of bytes until it is given more space
+class SlowStream : public Stream {
+ public:
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  int availableForWrite() override { return space_; }
+  size_t write(uint8_t c) override {
+    if (space_ == 0) {
+      return 0;
+    }
+    space_--;
+    written_ += static_cast<char>(c);
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t size) override {
+    size_t i = 0;
+    while (i < size && write(buffer[i])) {
+      i++;
+    }
+    return i;
+  }
+
+  int space_ = 0;
+  std::string written_;
+};
+
+static SlowStream* stream;
+
+void setUp(void) { stream = new SlowStream(); }
+
+void tearDown(void) { delete stream; }
+
+// Higher priorities are written first, in order within a priority.
+void test_priority_order(void) {
+  OutputQueue queue;
+  queue.push("$IIXDR,1", OutputPriority::low);
+  queue.push("$IIHDT,1", OutputPriority::normal);
+  queue.push("$APAPB,1", OutputPriority::high);
+  queue.push("$APAPB,2", OutputPriority::high);
+  TEST_ASSERT_EQUAL_INT(4, queue.get_depth());
+
+  stream->space_ = 1000;
+  queue.drain(stream);
+  TEST_ASSERT_EQUAL_STRING(
+      "$APAPB,1\r\n$APAPB,2\r\n$IIHDT,1\r\n$IIXDR,1\r\n",
+      stream->written_.c_str());
+  TEST_ASSERT_TRUE(queue.empty());
+  TEST_ASSERT_EQUAL_UINT32(4, queue.get_written_count());
+  TEST_ASSERT_EQUAL_INT(4, queue.get_max_depth());
+}
+
+// A partly written sentence is finished before a higher priority one.
+void test_partial_writes(void) {
+  OutputQueue queue;
+  queue.push("$IIXDR,1", OutputPriority::low);
+  stream->space_ = 4;
+  TEST_ASSERT_EQUAL_INT(4, queue.drain(stream));
+  TEST_ASSERT_EQUAL_INT(0, queue.drain(stream));
+
+  queue.push("$APAPB,1", OutputPriority::high);
+  stream->space_ = 1000;
+  queue.drain(stream);
+  TEST_ASSERT_EQUAL_STRING("$IIXDR,1\r\n$APAPB,1\r\n",
+                           stream->written_.c_str());
+}
+
+// A full queue drops low priority sentences to make room for higher ones.
+void test_drop_policy(void) {
+  OutputQueue queue;
+  for (size_t i = 0; i < kOutputQueueSlots; i++) {
+    TEST_ASSERT_TRUE(queue.push("$IIXDR,1", OutputPriority::low));
+  }
+  TEST_ASSERT_FALSE(queue.push("$IIXDR,2", OutputPriority::low));
+  TEST_ASSERT_TRUE(queue.push("$APAPB,1", OutputPriority::high));
+  TEST_ASSERT_EQUAL_UINT32(2, queue.get_dropped_count(OutputPriority::low));
+  TEST_ASSERT_EQUAL_UINT32(0, queue.get_dropped_count(OutputPriority::high));
+  TEST_ASSERT_EQUAL_INT(kOutputQueueSlots, queue.get_depth());
+
+  // Once only high priority sentences are left, new ones are dropped
+  for (size_t i = 1; i < kOutputQueueSlots; i++) {
+    queue.push("$APAPB,2", OutputPriority::high);
+  }
+  TEST_ASSERT_FALSE(queue.push("$APAPB,3", OutputPriority::high));
+  TEST_ASSERT_EQUAL_UINT32(1, queue.get_dropped_count(OutputPriority::high));
+  TEST_ASSERT_EQUAL_UINT32(kOutputQueueSlots + 2, queue.get_dropped_count());
+
+  stream->space_ = 10;
+  queue.drain(stream);
+  TEST_ASSERT_EQUAL_STRING("$APAPB,1\r\n", stream->written_.c_str());
+}
+
+// NMEA0183IO doesn't wait for a stream that reports its space and drains
+// on the event loop.
+void test_io_writes_without_blocking(void) {
+  // The event loop keeps a reference to the stream
+  auto* io_stream = new SlowStream();
+  io_stream->space_ = 4;
+  auto* io = new NMEA0183IO(io_stream);
+  io->set("$IIHDT,1");
+  io->write("$APAPB,1", OutputPriority::high);
+  TEST_ASSERT_EQUAL_INT(2, io->output_queue_.get_depth());
+  TEST_ASSERT_EQUAL_STRING("$IIH", io_stream->written_.c_str());
+
+  io_stream->space_ = 1000;
+  event_loop()->tick();
+  TEST_ASSERT_EQUAL_STRING("$IIHDT,1\r\n$APAPB,1\r\n",
+                           io_stream->written_.c_str());
+
+  io->set_blocking_writes(true);
+  io->set("$IIHDT,2");
+  TEST_ASSERT_EQUAL_STRING("$IIHDT,1\r\n$APAPB,1\r\n$IIHDT,2\r\n",
+                           io_stream->written_.c_str());
+}
+
+/// Stream without availableForWrite(), which then always reports 0
+class PlainStream : public Stream {
+ public:
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  size_t write(uint8_t c) override {
+    written_ += static_cast<char>(c);
+    return 1;
+  }
+
+  std::string written_;
+};
+
+// Sentences are written directly to a stream that never reports space.
+void test_io_writes_to_plain_stream(void) {
+  auto* io_stream = new PlainStream();
+  auto* io = new NMEA0183IO(io_stream);
+  io->set("$IIHDT,1");
+  io->write("$APAPB,1", OutputPriority::high);
+  TEST_ASSERT_TRUE(io->output_queue_.empty());
+  TEST_ASSERT_EQUAL_STRING("$IIHDT,1\r\n$APAPB,1\r\n",
+                           io_stream->written_.c_str());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_priority_order);
+  RUN_TEST(test_partial_writes);
+  RUN_TEST(test_drop_policy);
+  RUN_TEST(test_io_writes_without_blocking);
+  RUN_TEST(test_io_writes_to_plain_stream);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_priority_order);
+  RUN_TEST(test_partial_writes);
+  RUN_TEST(test_drop_policy);
+  RUN_TEST(test_io_writes_without_blocking);
+  RUN_TEST(test_io_writes_to_plain_stream);
+
+  return UNITY_END();
+}
+#endif
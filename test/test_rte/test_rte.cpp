@@ -23,11 +23,11 @@ void test_rte_single_sentence(void) {
   parser->set("$GPRTE,1,1,c,ROUTE1,WP1,WP2,WP3*44");
 
   TEST_ASSERT_EQUAL_STRING("ROUTE1", rte->route_id_.get().c_str());
-  std::vector<String> wps = rte->waypoints_.get();
-  TEST_ASSERT_EQUAL_INT(3, wps.size());
-  TEST_ASSERT_EQUAL_STRING("WP1", wps[0].c_str());
-  TEST_ASSERT_EQUAL_STRING("WP2", wps[1].c_str());
-  TEST_ASSERT_EQUAL_STRING("WP3", wps[2].c_str());
+  const RouteWaypoints* wps = rte->waypoints_.get();
+  TEST_ASSERT_EQUAL_INT(3, wps->size);
+  TEST_ASSERT_EQUAL_STRING("WP1", wps->ids[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("WP2", wps->ids[1].c_str());
+  TEST_ASSERT_EQUAL_STRING("WP3", wps->ids[2].c_str());
 }
 
 void test_rte_multi_sentence(void) {
@@ -38,13 +38,30 @@ void test_rte_multi_sentence(void) {
   parser->set("$GPRTE,2,2,c,0,FATEA,OCEAI*11");
 
   TEST_ASSERT_EQUAL_STRING("0", rte->route_id_.get().c_str());
-  std::vector<String> wps = rte->waypoints_.get();
-  TEST_ASSERT_EQUAL_INT(5, wps.size());
-  TEST_ASSERT_EQUAL_STRING("PBRCPK", wps[0].c_str());
-  TEST_ASSERT_EQUAL_STRING("CPNPT", wps[1].c_str());
-  TEST_ASSERT_EQUAL_STRING("BABRU", wps[2].c_str());
-  TEST_ASSERT_EQUAL_STRING("FATEA", wps[3].c_str());
-  TEST_ASSERT_EQUAL_STRING("OCEAI", wps[4].c_str());
+  const RouteWaypoints* wps = rte->waypoints_.get();
+  TEST_ASSERT_EQUAL_INT(5, wps->size);
+  TEST_ASSERT_EQUAL_STRING("PBRCPK", wps->ids[0].c_str());
+  TEST_ASSERT_EQUAL_STRING("CPNPT", wps->ids[1].c_str());
+  TEST_ASSERT_EQUAL_STRING("BABRU", wps->ids[2].c_str());
+  TEST_ASSERT_EQUAL_STRING("FATEA", wps->ids[3].c_str());
+  TEST_ASSERT_EQUAL_STRING("OCEAI", wps->ids[4].c_str());
+}
+
+// A route with a missing sentence is not emitted.
+void test_rte_missing_sentence(void) {
+  int emit_count = 0;
+  rte->waypoints_.attach([&emit_count]() { emit_count++; });
+
+  parser->set("$GPRTE,3,1,c,R2,A1,A2*56");
+  parser->set("$GPRTE,3,3,c,R2,A5*0F");
+  TEST_ASSERT_EQUAL_INT(0, emit_count);
+  TEST_ASSERT_EQUAL_UINT32(1, rte->get_dropped_count());
+  TEST_ASSERT_EQUAL_UINT32(1, rte->get_partial_count());
+
+  parser->set("$GPRTE,1,1,c,R3,B1*09");
+  TEST_ASSERT_EQUAL_INT(1, emit_count);
+  TEST_ASSERT_EQUAL_STRING("R3", rte->route_id_.get().c_str());
+  TEST_ASSERT_EQUAL_INT(1, rte->waypoints_.get()->size);
 }
 
 #ifdef ARDUINO
@@ -54,6 +71,7 @@ void setup() {
 
   RUN_TEST(test_rte_single_sentence);
   RUN_TEST(test_rte_multi_sentence);
+  RUN_TEST(test_rte_missing_sentence);
 
   UNITY_END();
 }
@@ -65,6 +83,7 @@ int main(int argc, char** argv) {
 
   RUN_TEST(test_rte_single_sentence);
   RUN_TEST(test_rte_multi_sentence);
+  RUN_TEST(test_rte_missing_sentence);
 
   return UNITY_END();
 }
@@ -0,0 +1,111 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/transforms/satellite_delta.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static GNSSSatelliteDeltaTransform* delta_transform;
+static int emit_count = 0;
+static int keyframe_count = 0;
+static GNSSSatelliteDelta last_delta;
+
+static GNSSSatellite Satellite(GNSSSystem system, int id, int snr) {
+  GNSSSatellite satellite;
+  satellite.system = system;
+  satellite.id = id;
+  satellite.elevation = 30;
+  satellite.azimuth = 120;
+  satellite.snr = snr;
+  satellite.signal_id = 1;
+  return satellite;
+}
+
+void setUp(void) {
+  delta_transform = new GNSSSatelliteDeltaTransform(3);
+  emit_count = 0;
+  keyframe_count = 0;
+  delta_transform->attach([]() {
+    emit_count++;
+    last_delta = *delta_transform->get();
+  });
+  delta_transform->keyframe_.attach([]() { keyframe_count++; });
+}
+
+void tearDown(void) { delete delta_transform; }
+
+void test_first_cycle_is_keyframe(void) {
+  GNSSSatelliteTable cycle;
+  cycle.push_back(Satellite(GNSSSystem::gps, 15, 43));
+  cycle.push_back(Satellite(GNSSSystem::glonass, 73, 35));
+  delta_transform->set(&cycle);
+
+  TEST_ASSERT_TRUE(last_delta.keyframe);
+  TEST_ASSERT_EQUAL_INT(2, (int)last_delta.satellites.size());
+  TEST_ASSERT_EQUAL_INT(1, keyframe_count);
+}
+
+// Only added, changed and removed satellites go into a delta.
+void test_delta_contents(void) {
+  GNSSSatelliteTable cycle;
+  cycle.push_back(Satellite(GNSSSystem::gps, 15, 43));
+  cycle.push_back(Satellite(GNSSSystem::gps, 17, 39));
+  cycle.push_back(Satellite(GNSSSystem::glonass, 73, 35));
+  delta_transform->set(&cycle);
+
+  GNSSSatelliteTable next;
+  next.push_back(Satellite(GNSSSystem::gps, 15, 43));  // unchanged
+  next.push_back(Satellite(GNSSSystem::glonass, 73, 36));  // SNR changed
+  next.push_back(Satellite(GNSSSystem::galileo, 9, 39));  // added
+  delta_transform->set(&next);  // GPS 17 removed
+
+  TEST_ASSERT_FALSE(last_delta.keyframe);
+  TEST_ASSERT_EQUAL_INT(2, (int)last_delta.satellites.size());
+  TEST_ASSERT_EQUAL_INT(73, last_delta.satellites[0].id);
+  TEST_ASSERT_EQUAL_INT(36, last_delta.satellites[0].snr);
+  TEST_ASSERT_EQUAL_INT(9, last_delta.satellites[1].id);
+  TEST_ASSERT_EQUAL_INT(1, (int)last_delta.removed.size());
+  TEST_ASSERT_EQUAL_INT(17, last_delta.removed[0].id);
+  TEST_ASSERT_EQUAL_INT(1, keyframe_count);
+  // The keyframe output points to the latest whole list
+  TEST_ASSERT_EQUAL_INT(3, (int)delta_transform->keyframe_.get()->size());
+  TEST_ASSERT_EQUAL_INT(9, (*delta_transform->keyframe_.get())[2].id);
+}
+
+void test_periodic_keyframe(void) {
+  GNSSSatelliteTable cycle;
+  cycle.push_back(Satellite(GNSSSystem::gps, 15, 43));
+  for (int i = 0; i < 4; i++) {
+    delta_transform->set(&cycle);
+  }
+
+  // Keyframes on cycles 1 and 4 with an interval of 3
+  TEST_ASSERT_EQUAL_INT(4, emit_count);
+  TEST_ASSERT_EQUAL_INT(2, keyframe_count);
+  TEST_ASSERT_TRUE(last_delta.keyframe);
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_first_cycle_is_keyframe);
+  RUN_TEST(test_delta_contents);
+  RUN_TEST(test_periodic_keyframe);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_first_cycle_is_keyframe);
+  RUN_TEST(test_delta_contents);
+  RUN_TEST(test_periodic_keyframe);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,223 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/data/json_writer.h"
+#include "sensesp_nmea0183/transforms/satellite_delta.h"
+#include "sensesp_nmea0183/transforms/streaming_sk_output.h"
+
+#ifndef ARDUINO
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#endif
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+#ifndef ARDUINO
+// Heap bytes in use, counted by replacing the global operator new and
+// delete. Every block has its size stored in front of it.
+static size_t heap_in_use = 0;
+static constexpr size_t kHeapHeader = alignof(std::max_align_t);
+
+void* operator new(size_t size) {
+  char* block = static_cast<char*>(malloc(size + kHeapHeader));
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<size_t*>(block) = size;
+  heap_in_use += size;
+  return block + kHeapHeader;
+}
+
+void operator delete(void* p) noexcept {
+  if (p == nullptr) {
+    return;
+  }
+  char* block = static_cast<char*>(p) - kHeapHeader;
+  heap_in_use -= *reinterpret_cast<size_t*>(block);
+  free(block);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+#endif
+
+static GNSSSatelliteTable table;
+
+/// serializeJson() of the ArduinoJson document built by convertToJson
+template <typename T>
+static String DocumentJson(const T& value) {
+  JsonDocument doc;
+  doc["value"] = value;
+  String json;
+  serializeJson(doc["value"], json);
+  return json;
+}
+
+template <typename T>
+static String StreamedJson(const T& value) {
+  StringPrint buffer;
+  JsonWriter writer(buffer);
+  WriteJson(value, writer);
+  TEST_ASSERT_TRUE(writer.ok());
+  TEST_ASSERT_EQUAL_UINT32(buffer.length(), writer.size());
+  return buffer.str();
+}
+
+void setUp(void) {
+  table.clear();
+
+  GNSSSatellite satellite;
+  satellite.system = GNSSSystem::gps;
+  satellite.id = 15;
+  satellite.elevation = 45;
+  satellite.azimuth = 310;
+  satellite.snr = 43;
+  satellite.signal_id = 1;
+  table.push_back(satellite);
+
+  // Not tracked, negative elevation, pre-4.10 sentence without signal ID
+  satellite.system = GNSSSystem::glonass;
+  satellite.id = 73;
+  satellite.elevation = -2;
+  satellite.azimuth = kGNSSSatelliteNoAzimuth;
+  satellite.snr = kGNSSSatelliteNoSNR;
+  satellite.signal_id = kGNSSSatelliteNoSignal;
+  table.push_back(satellite);
+}
+
+void tearDown(void) {}
+
+void test_table_json_matches_document(void) {
+  String streamed = StreamedJson(table);
+  TEST_ASSERT_EQUAL_STRING(
+      "[{\"system\":\"GPS\",\"id\":15,\"elevation\":45,\"azimuth\":310,"
+      "\"snr\":43,\"signal\":\"GPS L1 C/A\"},"
+      "{\"system\":\"GLONASS\",\"id\":73,\"elevation\":-2,\"azimuth\":null,"
+      "\"snr\":null,\"signal\":\"\"}]",
+      streamed.c_str());
+  TEST_ASSERT_EQUAL_STRING(DocumentJson(table).c_str(), streamed.c_str());
+
+  GNSSSatelliteTable empty;
+  TEST_ASSERT_EQUAL_STRING("[]", StreamedJson(empty).c_str());
+}
+
+void test_delta_json_matches_document(void) {
+  GNSSSatelliteDelta delta;
+  delta.keyframe = true;
+  delta.satellites = table;
+  TEST_ASSERT_EQUAL_STRING(DocumentJson(delta).c_str(),
+                           StreamedJson(delta).c_str());
+
+  delta.keyframe = false;
+  delta.satellites.clear();
+  delta.removed = table;
+  String streamed = StreamedJson(delta);
+  TEST_ASSERT_EQUAL_STRING(DocumentJson(delta).c_str(), streamed.c_str());
+  TEST_ASSERT_EQUAL_STRING("{\"keyframe\":false,\"satellites\":[],",
+                           streamed.substring(0, 34).c_str());
+}
+
+// The SK output attaches the streamed JSON as the delta value.
+void test_streaming_sk_output(void) {
+  auto* output = new StreamingSKOutput<GNSSSatelliteTable>(
+      "navigation.gnss.satellitesInView");
+  output->set(table);
+
+  JsonDocument doc;
+  output->as_signalk_json(doc);
+  String json;
+  serializeJson(doc, json);
+  String expected = "{\"path\":\"navigation.gnss.satellitesInView\",\"value\":" +
+                    DocumentJson(table) + "}";
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), json.c_str());
+  TEST_ASSERT_EQUAL_STRING(DocumentJson(table).c_str(),
+                           output->get_json().c_str());
+
+  delete output;
+}
+
+#ifndef ARDUINO
+// No memory is kept between deltas, whether the JSON fits the scratch area
+// or not.
+void test_streaming_sk_output_keeps_no_memory(void) {
+  GNSSSatelliteTable full;
+  GNSSSatellite satellite;
+  satellite.system = GNSSSystem::galileo;
+  satellite.elevation = 45;
+  satellite.azimuth = 310;
+  satellite.snr = 43;
+  satellite.signal_id = 7;
+  for (size_t i = 0; i < full.capacity(); i++) {
+    satellite.id = i + 1;
+    full.push_back(satellite);
+  }
+  TEST_ASSERT_GREATER_THAN_INT(kStreamingSKScratchSize,
+                               DocumentJson(full).length());
+
+  // Typed on a pointer, as ConnectGNSS() wires it
+  auto* output = new StreamingSKOutput<const GNSSSatelliteTable*>(
+      "navigation.gnss.satellitesInView");
+  TEST_ASSERT_EQUAL_STRING("null", output->get_json().c_str());
+  for (const GNSSSatelliteTable* value : {&table, &full, &table}) {
+    output->set(value);
+    size_t heap_before = heap_in_use;
+    {
+      JsonDocument doc;
+      output->as_signalk_json(doc);
+      String json;
+      serializeJson(doc["value"], json);
+      TEST_ASSERT_EQUAL_STRING(DocumentJson(*value).c_str(), json.c_str());
+    }
+    TEST_ASSERT_EQUAL_UINT32(heap_before, heap_in_use);
+  }
+  delete output;
+}
+#endif
+
+void test_writer_escapes_and_nesting(void) {
+  StringPrint buffer;
+  JsonWriter writer(buffer);
+  writer.begin_object();
+  writer.key("text");
+  writer.value("a\"b\\c\n");
+  writer.key("list");
+  writer.begin_array();
+  writer.value(-2147483647L - 1);
+  writer.value(0UL);
+  writer.begin_object();
+  writer.end_object();
+  writer.null();
+  writer.end_array();
+  writer.end_object();
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"text\":\"a\\\"b\\\\c\\n\",\"list\":[-2147483648,0,{},null]}",
+      buffer.c_str());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_table_json_matches_document);
+  RUN_TEST(test_delta_json_matches_document);
+  RUN_TEST(test_streaming_sk_output);
+  RUN_TEST(test_writer_escapes_and_nesting);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_table_json_matches_document);
+  RUN_TEST(test_delta_json_matches_document);
+  RUN_TEST(test_streaming_sk_output);
+  RUN_TEST(test_streaming_sk_output_keeps_no_memory);
+  RUN_TEST(test_writer_escapes_and_nesting);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,111 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/sentence_parser/sentence_assembler.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+using Assembler = SentenceAssembler<int, int, 4, 2>;
+
+static Assembler* assembler;
+
+void setUp(void) { assembler = new Assembler(1000); }
+
+void tearDown(void) { delete assembler; }
+
+void test_assembler_in_order(void) {
+  auto* group = assembler->accept(7, 2, 1, 0);
+  TEST_ASSERT_NOT_NULL(group);
+  TEST_ASSERT_TRUE(assembler->add(group, 10));
+  TEST_ASSERT_FALSE(group->complete());
+
+  group = assembler->accept(7, 2, 2, 10);
+  TEST_ASSERT_NOT_NULL(group);
+  TEST_ASSERT_TRUE(assembler->add(group, 20));
+  TEST_ASSERT_TRUE(group->complete());
+  TEST_ASSERT_EQUAL_INT(2, (int)group->size);
+  TEST_ASSERT_EQUAL_INT(20, group->items[1]);
+  assembler->release(group);
+
+  TEST_ASSERT_EQUAL_UINT32(1, assembler->get_completed_count());
+  TEST_ASSERT_EQUAL_UINT32(0, assembler->get_dropped_count());
+  TEST_ASSERT_EQUAL_UINT32(0, assembler->get_partial_count());
+}
+
+// Skipped and restarted groups are counted and never complete.
+void test_assembler_out_of_sequence(void) {
+  // No start seen
+  TEST_ASSERT_NULL(assembler->accept(7, 3, 2, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, assembler->get_dropped_count());
+
+  // Sentence 2 missing
+  TEST_ASSERT_NOT_NULL(assembler->accept(7, 3, 1, 0));
+  TEST_ASSERT_NULL(assembler->accept(7, 3, 3, 0));
+  TEST_ASSERT_EQUAL_UINT32(2, assembler->get_dropped_count());
+  TEST_ASSERT_EQUAL_UINT32(1, assembler->get_partial_count());
+
+  // Restarted before completion
+  TEST_ASSERT_NOT_NULL(assembler->accept(7, 3, 1, 0));
+  auto* group = assembler->accept(7, 3, 1, 0);
+  TEST_ASSERT_NOT_NULL(group);
+  TEST_ASSERT_EQUAL_INT(0, (int)group->size);
+  TEST_ASSERT_EQUAL_UINT32(2, assembler->get_partial_count());
+
+  // Sentence count changes mid-group
+  TEST_ASSERT_NULL(assembler->accept(7, 4, 2, 0));
+  TEST_ASSERT_EQUAL_UINT32(3, assembler->get_partial_count());
+
+  // Invalid numbering
+  TEST_ASSERT_NULL(assembler->accept(7, 2, 3, 0));
+  TEST_ASSERT_EQUAL_UINT32(4, assembler->get_dropped_count());
+}
+
+// Groups of different keys interleave; slots are bounded and time out.
+void test_assembler_keys_and_timeout(void) {
+  auto* a = assembler->accept(1, 2, 1, 0);
+  auto* b = assembler->accept(2, 2, 1, 0);
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_NOT_NULL(b);
+  TEST_ASSERT_TRUE(a != b);
+
+  // Both slots are in use
+  TEST_ASSERT_NULL(assembler->accept(3, 2, 1, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, assembler->get_dropped_count());
+
+  TEST_ASSERT_TRUE(assembler->accept(2, 2, 2, 500)->complete());
+  TEST_ASSERT_TRUE(assembler->accept(1, 2, 2, 600)->complete());
+  assembler->release(a);
+  assembler->release(b);
+
+  // A stale group is abandoned and its slot reused
+  TEST_ASSERT_NOT_NULL(assembler->accept(1, 2, 1, 1000));
+  TEST_ASSERT_NOT_NULL(assembler->accept(2, 2, 1, 1500));
+  TEST_ASSERT_NOT_NULL(assembler->accept(3, 2, 1, 2500));
+  TEST_ASSERT_EQUAL_UINT32(1, assembler->get_partial_count());
+  TEST_ASSERT_NULL(assembler->accept(1, 2, 2, 2500));
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_assembler_in_order);
+  RUN_TEST(test_assembler_out_of_sequence);
+  RUN_TEST(test_assembler_keys_and_timeout);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_assembler_in_order);
+  RUN_TEST(test_assembler_out_of_sequence);
+  RUN_TEST(test_assembler_keys_and_timeout);
+
+  return UNITY_END();
+}
+#endif
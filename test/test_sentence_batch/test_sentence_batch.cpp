@@ -0,0 +1,140 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/wind_sentence_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+/// Sets its first output before failing on an "X" in field 2
+class PartialSentenceParser : public SentenceParser {
+ public:
+  PartialSentenceParser(NMEA0183Parser* nmea) : SentenceParser(nmea) {
+    declare_outputs({&first_, &second_});
+  }
+  bool parse_fields(const char* field_strings, const int field_offsets[],
+                    int num_fields) override {
+    if (num_fields < 3) {
+      return false;
+    }
+    first_.set(atof(field_strings + field_offsets[1]));
+    if (strcmp(field_strings + field_offsets[2], "X") == 0) {
+      return false;
+    }
+    second_.set(atof(field_strings + field_offsets[2]));
+    return true;
+  }
+  const char* sentence_address() override { return "XXTST"; }
+
+  SentenceOutput<float> first_;
+  SentenceOutput<float> second_;
+};
+
+static NMEA0183Parser* parser;
+static MWVSentenceParser* mwv;
+static SentenceCoalescer* wind;
+static int wind_count;
+static float angle_seen;
+static float speed_seen;
+
+void setUp(void) {
+  parser = new NMEA0183Parser();
+  mwv = new MWVSentenceParser(parser);
+  wind = new SentenceCoalescer();
+  wind_count = 0;
+  angle_seen = 0;
+  speed_seen = 0;
+  wind->watch(&mwv->apparent_wind_angle_);
+  wind->watch(&mwv->apparent_wind_speed_);
+  wind->attach([]() {
+    wind_count++;
+    angle_seen = mwv->apparent_wind_angle_.get();
+    speed_seen = mwv->apparent_wind_speed_.get();
+  });
+}
+
+void tearDown(void) {
+  delete mwv;
+  delete wind;
+  delete parser;
+}
+
+// An observer of both fields runs once per sentence and sees both of them.
+void test_coalescer_once_per_sentence(void) {
+  mwv->set_batching(true);
+  int angle_count = 0;
+  float speed_seen_by_angle = 0;
+  mwv->apparent_wind_angle_.attach([&angle_count, &speed_seen_by_angle]() {
+    angle_count++;
+    speed_seen_by_angle = mwv->apparent_wind_speed_.get();
+  });
+
+  parser->set("$WIMWV,045.0,R,10.0,M,A*10");
+  TEST_ASSERT_EQUAL_INT(1, wind_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 45.0 * DEG_TO_RAD, angle_seen);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 10.0, speed_seen);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 10.0, speed_seen_by_angle);
+
+  parser->set("$WIMWV,047.0,R,11.0,M,A*13");
+  TEST_ASSERT_EQUAL_INT(2, wind_count);
+  TEST_ASSERT_EQUAL_INT(2, angle_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 47.0 * DEG_TO_RAD, angle_seen);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 11.0, speed_seen);
+}
+
+// A sentence that fails to parse notifies nobody.
+void test_coalescer_skips_invalid_sentence(void) {
+  mwv->set_batching(true);
+  parser->set("$WIMWV,046.0,R,10.0,M,V*04");
+  TEST_ASSERT_EQUAL_INT(0, wind_count);
+}
+
+// Without batching, the coalescer runs for every output set.
+void test_coalescer_without_batching(void) {
+  parser->set("$WIMWV,045.0,R,10.0,M,A*10");
+  TEST_ASSERT_EQUAL_INT(2, wind_count);
+}
+
+// A sentence failing after some outputs were set leaves all outputs as
+// they were.
+void test_failed_sentence_keeps_values(void) {
+  auto* partial = new PartialSentenceParser(parser);
+  partial->set_batching(true);
+  int notify_count = 0;
+  partial->first_.attach([&notify_count]() { notify_count++; });
+
+  parser->set("$XXTST,1.5,2.5*50");
+  TEST_ASSERT_EQUAL_INT(1, notify_count);
+  parser->set("$XXTST,3.5,X*23");
+  TEST_ASSERT_EQUAL_INT(1, notify_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 1.5, partial->first_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 2.5, partial->second_.get());
+  delete partial;
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_coalescer_once_per_sentence);
+  RUN_TEST(test_coalescer_skips_invalid_sentence);
+  RUN_TEST(test_coalescer_without_batching);
+  RUN_TEST(test_failed_sentence_keeps_values);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_coalescer_once_per_sentence);
+  RUN_TEST(test_coalescer_skips_invalid_sentence);
+  RUN_TEST(test_coalescer_without_batching);
+  RUN_TEST(test_failed_sentence_keeps_values);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,102 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/data/sentence_builder.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/navigation_sentence_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static char buffer[83];
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// The checksum is the same as AddChecksum() computes.
+void test_build_hdt(void) {
+  SentenceBuilder sentence(buffer, sizeof(buffer));
+  sentence.start("IIHDT").add_float(98.3, 1).add_char('T');
+  TEST_ASSERT_EQUAL_STRING("$IIHDT,98.3,T*10", sentence.finish());
+
+  String expected = "$IIHDT,98.3,T";
+  AddChecksum(expected);
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), buffer);
+}
+
+// Rounding minutes up to 60 carries into the degrees.
+void test_position_and_time(void) {
+  SentenceBuilder sentence(buffer, sizeof(buffer));
+  sentence.start("GPGLL")
+      .add_latitude(60.1234567)
+      .add_longitude(-24.9999999)
+      .add_time(static_cast<time_t>(1700000000))
+      .add_char('A');
+  TEST_ASSERT_EQUAL_STRING("$GPGLL,6007.4074,N,02500.0000,W,221320.00,A*17",
+                           sentence.finish());
+
+  sentence.start("GPZDA").add_time(23, 59, 59.996f);
+  TEST_ASSERT_EQUAL_STRING("$GPZDA,000000.00", sentence.c_str());
+}
+
+// Invalid values are written as empty fields, and negative zero as zero.
+void test_invalid_values_and_date(void) {
+  SentenceBuilder sentence(buffer, sizeof(buffer));
+  sentence.start("IIXDR")
+      .add_float(NAN, 1)
+      .add_int(kInvalidInt)
+      .add_float(-0.001, 1)
+      .add_date(static_cast<time_t>(1700000000));
+  TEST_ASSERT_EQUAL_STRING("$IIXDR,,,0.0,141123*64", sentence.finish());
+
+  sentence.start("GPGLL").add_latitude(kInvalidDouble);
+  TEST_ASSERT_EQUAL_STRING("$GPGLL,,", sentence.c_str());
+  sentence.start("IIMTW").add_int(-12).add_float(-3.14159, 3);
+  TEST_ASSERT_EQUAL_STRING("$IIMTW,-12,-3.142", sentence.c_str());
+}
+
+// A built sentence parses back, and an overflowing one is not written.
+void test_round_trip_and_overflow(void) {
+  NMEA0183Parser parser;
+  HDTSentenceParser hdt(&parser);
+  SentenceBuilder sentence(buffer, sizeof(buffer));
+  sentence.start("HCHDT").add_float(271.25, 2).add_char('T');
+  parser.parse(sentence.finish());
+  TEST_ASSERT_EQUAL_INT(1, hdt.get_rx_count());
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 271.25 * DEG_TO_RAD,
+                           hdt.true_heading_.get());
+
+  char small[16];
+  SentenceBuilder overflowing(small, sizeof(small));
+  overflowing.start("HCHDT").add_float(271.25, 2).add_char('T');
+  TEST_ASSERT_FALSE(overflowing.ok());
+  TEST_ASSERT_NULL(overflowing.finish());
+  TEST_ASSERT_TRUE(strlen(small) < sizeof(small));
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_build_hdt);
+  RUN_TEST(test_position_and_time);
+  RUN_TEST(test_invalid_values_and_date);
+  RUN_TEST(test_round_trip_and_overflow);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_build_hdt);
+  RUN_TEST(test_position_and_time);
+  RUN_TEST(test_invalid_values_and_date);
+  RUN_TEST(test_round_trip_and_overflow);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,162 @@
+#include <unity.h>
+
+#include <string>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/sentence_encoder/gnss_sentence_encoder.h"
+#include "sensesp_nmea0183/sentence_encoder/navigation_sentence_encoder.h"
+#include "sensesp_nmea0183/sentence_encoder/waypoint_sentence_encoder.h"
+#include "sensesp_nmea0183/sentence_encoder/wind_sentence_encoder.h"
+#include "sensesp_nmea0183/sentence_parser/gnss_sentence_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+/// Stream collecting the written sentences
+class CaptureStream : public Stream {
+ public:
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  int availableForWrite() override { return 1024; }
+  size_t write(uint8_t c) override {
+    written_ += static_cast<char>(c);
+    return 1;
+  }
+
+  std::string written_;
+};
+
+// The event loop keeps references to these and to the encoders and their
+// data, so they are never deleted
+static CaptureStream* stream;
+static NMEA0183IO* io;
+static NMEA0183Encoder* encoder;
+
+void setUp(void) {
+  stream = new CaptureStream();
+  io = new NMEA0183IO(stream);
+  encoder = new NMEA0183Encoder(io);
+}
+
+void tearDown(void) {}
+
+/// Advance the time and run the event loop
+static void Run(unsigned long ms) {
+  for (unsigned long t = 0; t < ms; t += kEncoderSchedulerIntervalMs) {
+    delay(kEncoderSchedulerIntervalMs);
+    event_loop()->tick();
+  }
+}
+
+// The sentence is sent at its interval and encoded only after changes.
+void test_hdt_interval_and_reencoding(void) {
+  auto* heading = new HeadingData();
+  auto* hdt = new HDTSentenceEncoder(encoder, heading, 100);
+  Run(200);
+  TEST_ASSERT_EQUAL_STRING("", stream->written_.c_str());
+
+  heading->true_heading.set(98.3 * DEG_TO_RAD);
+  Run(300);
+  TEST_ASSERT_EQUAL_INT(1, hdt->get_encode_count());
+  TEST_ASSERT_EQUAL_INT(3, hdt->get_tx_count());
+  TEST_ASSERT_EQUAL_STRING("$IIHDT,98.3,T*10\r\n$IIHDT,98.3,T*10\r\n"
+                           "$IIHDT,98.3,T*10\r\n",
+                           stream->written_.c_str());
+
+  heading->true_heading.set(-90 * DEG_TO_RAD);
+  Run(100);
+  TEST_ASSERT_EQUAL_INT(2, hdt->get_encode_count());
+  TEST_ASSERT_EQUAL_STRING("$IIHDT,270.0,T*27", hdt->get_sentence());
+}
+
+// Sending stops when the inputs stop changing.
+void test_stale_inputs_not_sent(void) {
+  auto* depth = new DepthTemperatureData();
+  auto* dbt = new DBTSentenceEncoder(encoder, depth, 100);
+  dbt->set_max_age(250);
+  depth->depth_below_transducer.set(3.2);
+  Run(1000);
+  TEST_ASSERT_EQUAL_INT(3, dbt->get_tx_count());
+  TEST_ASSERT_EQUAL_STRING("$IIDBT,10.5,f,3.2,M,1.7,F*22",
+                           dbt->get_sentence());
+}
+
+void test_mwv_and_xte(void) {
+  auto* wind = new ApparentWindData();
+  auto* waypoint = new WaypointData();
+  auto* mwv = new MWVSentenceEncoder(encoder, wind, 100);
+  new XTESentenceEncoder(encoder, waypoint, 100);
+  wind->angle.set(-30 * DEG_TO_RAD);
+  wind->speed.set(5.0);
+  waypoint->cross_track_error.set(-185.2);
+  Run(100);
+  TEST_ASSERT_EQUAL_INT(1, mwv->get_encode_count());
+  TEST_ASSERT_EQUAL_STRING(
+      "$IIMWV,330.0,R,9.7,N,A*33\r\n$IIXTE,A,A,0.100,L,N,A*25\r\n",
+      stream->written_.c_str());
+
+  // Invalid inputs are not sent
+  wind->speed.set(kInvalidFloat);
+  Run(100);
+  TEST_ASSERT_NULL(mwv->get_sentence());
+  TEST_ASSERT_EQUAL_INT(1, mwv->get_tx_count());
+}
+
+// An encoded RMC sentence parses back to the same fix.
+void test_rmc_round_trip(void) {
+  auto* gnss = new GNSSData();
+  auto* rmc = new RMCSentenceEncoder(encoder, gnss, 100);
+  GNSSFix fix;
+  fix.position = {60.1234567, -24.9876543};
+  fix.datetime = 1700000000;
+  fix.quality = 1;
+  fix.speed = 2.5;
+  fix.true_course = 45 * DEG_TO_RAD;
+  fix.variation = -7.5 * DEG_TO_RAD;
+  gnss->fix.set(fix);
+  Run(100);
+  TEST_ASSERT_NOT_NULL(rmc->get_sentence());
+
+  NMEA0183Parser parser;
+  RMCSentenceParser rmc_parser(&parser);
+  parser.parse(rmc->get_sentence());
+  TEST_ASSERT_EQUAL_INT(1, rmc_parser.get_rx_count());
+  TEST_ASSERT_DOUBLE_WITHIN(0.000002, 60.1234567,
+                            rmc_parser.position_.get().latitude);
+  TEST_ASSERT_DOUBLE_WITHIN(0.000002, -24.9876543,
+                            rmc_parser.position_.get().longitude);
+  TEST_ASSERT_EQUAL_INT(1700000000, rmc_parser.datetime_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.05, 2.5, rmc_parser.speed_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 45 * DEG_TO_RAD,
+                           rmc_parser.true_course_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.01, -7.5 * DEG_TO_RAD,
+                           rmc_parser.variation_.get());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_hdt_interval_and_reencoding);
+  RUN_TEST(test_stale_inputs_not_sent);
+  RUN_TEST(test_mwv_and_xte);
+  RUN_TEST(test_rmc_round_trip);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_hdt_interval_and_reencoding);
+  RUN_TEST(test_stale_inputs_not_sent);
+  RUN_TEST(test_mwv_and_xte);
+  RUN_TEST(test_rmc_round_trip);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,169 @@
+#include <unity.h>
+
+#include <string>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/navigation_sentence_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+/// Stream reading from a fixed string
+class StringStream : public Stream {
+ public:
+  StringStream(const char* data) : data_{data} {}
+  int available() override { return data_.size() - position_; }
+  int read() override {
+    return available() > 0 ? static_cast<uint8_t>(data_[position_++]) : -1;
+  }
+  int peek() override {
+    return available() > 0 ? static_cast<uint8_t>(data_[position_]) : -1;
+  }
+  size_t write(uint8_t c) override { return 1; }
+
+ private:
+  std::string data_;
+  size_t position_ = 0;
+};
+
+static const char* kInput =
+    "$GPGSV,1,1,01,15,24,205,43*4A\r\n"
+    "$HCHDM,101.1,M*28\r\n"
+    "!AIVDM,1,1,,A,13aEOK?P00PD2wVMdLDRhgvL289?,0*26\r\n"
+    "$HCHDT,98.3,T*1B\r\n";
+
+static NMEA0183Parser* parser;
+static HDMSentenceParser* hdm;
+static HDTSentenceParser* hdt;
+static int sentence_count;
+
+void setUp(void) {
+  parser = new NMEA0183Parser();
+  hdm = new HDMSentenceParser(parser);
+  hdt = new HDTSentenceParser(parser);
+  sentence_count = 0;
+}
+
+void tearDown(void) {
+  delete hdt;
+  delete hdm;
+  delete parser;
+}
+
+static SentenceFramer MakeFramer() {
+  return SentenceFramer(
+      [](const char* sentence) {
+        sentence_count++;
+        parser->parse(sentence);
+      },
+      [](const char* address, size_t length) {
+        return parser->accepts_address(address, length);
+      });
+}
+
+// Only sentences with registered parsers are passed on.
+void test_framer_rejects_unparsed_addresses(void) {
+  SentenceFramer framer = MakeFramer();
+  framer.feed(reinterpret_cast<const uint8_t*>(kInput), strlen(kInput));
+
+  TEST_ASSERT_EQUAL_INT(2, sentence_count);
+  TEST_ASSERT_EQUAL_UINT32(2, framer.get_accepted_count());
+  TEST_ASSERT_EQUAL_UINT32(2, framer.get_rejected_count());
+  TEST_ASSERT_EQUAL_INT(1, hdm->get_rx_count());
+  TEST_ASSERT_EQUAL_INT(1, hdt->get_rx_count());
+}
+
+void test_framer_allow_and_deny(void) {
+  parser->allow_address("AIVDM");
+  parser->deny_address("..HDM");
+  SentenceFramer framer = MakeFramer();
+  framer.feed(reinterpret_cast<const uint8_t*>(kInput), strlen(kInput));
+
+  TEST_ASSERT_EQUAL_INT(2, sentence_count);
+  TEST_ASSERT_EQUAL_INT(0, hdm->get_rx_count());
+  TEST_ASSERT_EQUAL_INT(1, hdt->get_rx_count());
+
+  parser->allow_address("*");
+  framer.feed(reinterpret_cast<const uint8_t*>(kInput), strlen(kInput));
+  TEST_ASSERT_EQUAL_INT(5, sentence_count);
+  TEST_ASSERT_EQUAL_INT(0, hdm->get_rx_count());
+}
+
+// A start character resynchronizes, and overlong lines are skipped.
+void test_framer_resync_and_overflow(void) {
+  SentenceFramer framer = MakeFramer();
+  const char* garbled = "$HCHDT,12$HCHDT,98.3,T*1B\n";
+  framer.feed(reinterpret_cast<const uint8_t*>(garbled), strlen(garbled));
+  TEST_ASSERT_EQUAL_INT(1, sentence_count);
+  TEST_ASSERT_EQUAL_INT(1, hdt->get_rx_count());
+
+  String overlong = "$HCHDT,";
+  for (int i = 0; i < 200; i++) {
+    overlong += "9";
+  }
+  overlong += "\r\n$HCHDT,98.3,T*1B\r\n";
+  framer.feed(reinterpret_cast<const uint8_t*>(overlong.c_str()),
+              overlong.length());
+  TEST_ASSERT_EQUAL_UINT32(1, framer.get_overflow_count());
+  TEST_ASSERT_EQUAL_INT(2, sentence_count);
+  TEST_ASSERT_EQUAL_INT(2, hdt->get_rx_count());
+}
+
+void test_io_reads_stream(void) {
+  // The event loop keeps a reference to the stream
+  auto* stream = new StringStream(kInput);
+  auto* io = new NMEA0183IO(stream);
+  auto* io_hdt = new HDTSentenceParser(&io->parser_);
+  event_loop()->tick();
+
+  TEST_ASSERT_EQUAL_INT(1, io_hdt->get_rx_count());
+  TEST_ASSERT_EQUAL_UINT32(1, io->framer_.get_accepted_count());
+  TEST_ASSERT_EQUAL_UINT32(3, io->framer_.get_rejected_count());
+}
+
+// The deprecated line_producer_ still emits the sentences read.
+void test_io_line_producer(void) {
+  auto* stream = new StringStream(kInput);
+  auto* io = new NMEA0183IO(stream);
+  io->parser_.allow_address("*");
+  int line_count = 0;
+  int filtered_count = 0;
+  io->line_producer_->attach([&line_count]() { line_count++; });
+  io->sentence_filter_->attach([&filtered_count]() { filtered_count++; });
+  event_loop()->tick();
+
+  TEST_ASSERT_EQUAL_INT(4, line_count);
+  TEST_ASSERT_EQUAL_INT(4, filtered_count);
+  TEST_ASSERT_EQUAL_STRING("$HCHDT,98.3,T*1B",
+                           io->line_producer_->get().c_str());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_framer_rejects_unparsed_addresses);
+  RUN_TEST(test_framer_allow_and_deny);
+  RUN_TEST(test_framer_resync_and_overflow);
+  RUN_TEST(test_io_reads_stream);
+  RUN_TEST(test_io_line_producer);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_framer_rejects_unparsed_addresses);
+  RUN_TEST(test_framer_allow_and_deny);
+  RUN_TEST(test_framer_resync_and_overflow);
+  RUN_TEST(test_io_reads_stream);
+  RUN_TEST(test_io_line_producer);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,88 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/sentence_parser/gnss_sentence_parser.h"
+#include "sensesp_nmea0183/sentence_parser/wind_sentence_parser.h"
+#include "sensesp_nmea0183/static_parser.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+using WindParser =
+    NMEA0183StaticParser<GGASentenceParser, MWVSentenceParser,
+                         TrueWindMWVSentenceParser>;
+
+static WindParser* parser;
+
+void setUp(void) { parser = new WindParser(); }
+
+void tearDown(void) { delete parser; }
+
+void test_static_dispatch(void) {
+  parser->parse(
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47");
+
+  GGASentenceParser& gga = parser->get<GGASentenceParser>();
+  TEST_ASSERT_EQUAL_INT(1, gga.get_rx_count());
+  TEST_ASSERT_EQUAL_INT(8, gga.num_satellites_.get());
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 48.1173, gga.position_.get().latitude);
+  TEST_ASSERT_EQUAL_INT(0, parser->get<1>().get_rx_count());
+}
+
+void test_static_discriminator(void) {
+  parser->parse("$WIMWV,045.0,R,10.0,M,A*10");
+  parser->parse("$WIMWV,270.0,T,8.0,M,A*2B");
+  parser->parse("$WIMWV,090.0,T,6.0,M,A*29");
+
+  TEST_ASSERT_EQUAL_INT(1, parser->get<MWVSentenceParser>().get_rx_count());
+  TEST_ASSERT_EQUAL_INT(2,
+                        parser->get<TrueWindMWVSentenceParser>().get_rx_count());
+  TEST_ASSERT_FLOAT_WITHIN(
+      0.01, 6.0, parser->get<TrueWindMWVSentenceParser>().true_wind_speed_.get());
+}
+
+void test_static_accepts_address(void) {
+  TEST_ASSERT_TRUE(parser->accepts_address("GNGGA", 5));
+  TEST_ASSERT_TRUE(parser->accepts_address("IIMWV", 5));
+  TEST_ASSERT_FALSE(parser->accepts_address("GPRMC", 5));
+  TEST_ASSERT_FALSE(parser->accepts_address("GPGG", 4));
+  TEST_ASSERT_FALSE(parser->accepts_address("GPGGAX", 6));
+}
+
+void test_static_framer(void) {
+  const char* input =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$WIMWV,045.0,R,10.0,M,A*10\r\n";
+  SentenceFramer framer = parser->framer();
+  framer.feed(reinterpret_cast<const uint8_t*>(input), strlen(input));
+
+  TEST_ASSERT_EQUAL_INT(1, framer.get_rejected_count());
+  TEST_ASSERT_EQUAL_INT(1, framer.get_accepted_count());
+  TEST_ASSERT_EQUAL_INT(1, parser->get<MWVSentenceParser>().get_rx_count());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_static_dispatch);
+  RUN_TEST(test_static_discriminator);
+  RUN_TEST(test_static_accepts_address);
+  RUN_TEST(test_static_framer);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_static_dispatch);
+  RUN_TEST(test_static_discriminator);
+  RUN_TEST(test_static_accepts_address);
+  RUN_TEST(test_static_framer);
+
+  return UNITY_END();
+}
+#endif
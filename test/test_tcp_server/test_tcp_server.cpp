@@ -0,0 +1,252 @@
+#include <unity.h>
+
+#include <string>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/io/sentence_ring.h"
+#include "sensesp_nmea0183/io/tcp_server.h"
+
+#ifndef ARDUINO
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static const char* kSentence = "$HCHDT,98.3,T*1B";
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// The oldest whole sentences make room, and lapped readers are detected.
+void test_ring_overwrites_oldest(void) {
+  auto* ring = new SentenceRing();
+  uint32_t reader = ring->head();
+  size_t sentence_length = strlen(kSentence) + 2;
+  size_t count = kSentenceRingSize / sentence_length;
+  for (size_t i = 0; i < count; i++) {
+    ring->push(kSentence);
+  }
+  TEST_ASSERT_FALSE(ring->lapped(reader));
+  TEST_ASSERT_EQUAL_UINT32(0, ring->get_overwritten_count());
+
+  ring->push(kSentence);
+  TEST_ASSERT_TRUE(ring->lapped(reader));
+  TEST_ASSERT_EQUAL_UINT32(1, ring->get_overwritten_count());
+  TEST_ASSERT_EQUAL_UINT32(sentence_length, ring->tail());
+
+  // The data wraps around the end of the buffer but reads back whole
+  std::string read;
+  const uint8_t* data;
+  size_t length;
+  uint32_t cursor = ring->tail();
+  while ((length = ring->peek(cursor, &data)) > 0) {
+    read.append(reinterpret_cast<const char*>(data), length);
+    cursor += length;
+  }
+  TEST_ASSERT_EQUAL_INT(count * sentence_length, read.size());
+  TEST_ASSERT_EQUAL_INT(0, read.find(kSentence));
+  TEST_ASSERT_EQUAL_INT(ring->backlog(ring->tail()), read.size());
+  delete ring;
+}
+
+#ifndef ARDUINO
+/// Connect a blocking loopback client with a receive timeout
+static int ConnectClient(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct timeval timeout = {1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  struct sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address));
+  return fd;
+}
+
+/// Read until length bytes have been received, the timeout or EOF
+static std::string Receive(int fd, size_t length) {
+  std::string received;
+  char buffer[512];
+  while (received.size() < length) {
+    ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+    if (n <= 0) {
+      break;
+    }
+    received.append(buffer, n);
+  }
+  return received;
+}
+
+// Every client receives the sentences written after it connected.
+void test_fan_out_to_clients(void) {
+  NMEA0183TCPServer server(0);
+  TEST_ASSERT_TRUE(server.start(false));
+  int first = ConnectClient(server.get_port());
+  int second = ConnectClient(server.get_port());
+  usleep(10000);
+  server.poll();
+  TEST_ASSERT_EQUAL_INT(2, server.get_client_count());
+
+  server.write(kSentence);
+  server.write("$HCHDM,101.1,M*28");
+  server.poll();
+  std::string expected = "$HCHDT,98.3,T*1B\r\n$HCHDM,101.1,M*28\r\n";
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(),
+                           Receive(first, expected.size()).c_str());
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(),
+                           Receive(second, expected.size()).c_str());
+  TEST_ASSERT_EQUAL_INT(0, server.get_backlog());
+
+  // A closed client is noticed
+  close(first);
+  usleep(10000);
+  server.poll();
+  TEST_ASSERT_EQUAL_INT(1, server.get_client_count());
+  close(second);
+}
+
+// A client that falls behind the ring skips to the oldest sentence, or is
+// disconnected, and the input is never held up.
+void test_slow_client_policy(void) {
+  NMEA0183TCPServer skipping(0, SlowClientPolicy::skip);
+  NMEA0183TCPServer dropping(0, SlowClientPolicy::disconnect);
+  TEST_ASSERT_TRUE(skipping.start(false));
+  TEST_ASSERT_TRUE(dropping.start(false));
+  int skipped = ConnectClient(skipping.get_port());
+  int dropped = ConnectClient(dropping.get_port());
+  usleep(10000);
+  skipping.poll();
+  dropping.poll();
+
+  // Write more than the ring holds between two polls
+  size_t count = kSentenceRingSize / (strlen(kSentence) + 2) + 10;
+  for (size_t i = 0; i < count; i++) {
+    skipping.write(kSentence);
+    dropping.write(kSentence);
+  }
+  skipping.poll();
+  dropping.poll();
+
+  TEST_ASSERT_EQUAL_UINT32(1, skipping.get_skip_count());
+  std::string received = Receive(skipped, skipping.ring().backlog(
+                                              skipping.ring().tail()));
+  TEST_ASSERT_EQUAL_INT(0, received.find(kSentence));
+  TEST_ASSERT_EQUAL_INT(1, skipping.get_client_count());
+
+  TEST_ASSERT_EQUAL_UINT32(1, dropping.get_dropped_client_count());
+  TEST_ASSERT_EQUAL_INT(0, dropping.get_client_count());
+  TEST_ASSERT_EQUAL_STRING("", Receive(dropped, 1).c_str());
+  close(skipped);
+  close(dropped);
+}
+
+// A client cut off in the middle of a sentence by a skip has the line
+// ended before it continues with whole sentences.
+void test_skip_ends_partial_sentence(void) {
+  NMEA0183TCPServer server(0, SlowClientPolicy::skip);
+  TEST_ASSERT_TRUE(server.start(false));
+  size_t sentence_length = strlen(kSentence) + 2;
+
+  // Fill the connection until the sends stall within a sentence. Where
+  // they stall is up to the kernel, so a connection stalling at a sentence
+  // boundary is replaced.
+  int client = -1;
+  bool mid_sentence = false;
+  for (int attempt = 0; attempt < 8 && !mid_sentence; attempt++) {
+    if (client >= 0) {
+      close(client);
+    }
+    client = socket(AF_INET, SOCK_STREAM, 0);
+    int buffer_size = 2048;
+    setsockopt(client, SOL_SOCKET, SO_RCVBUF, &buffer_size,
+               sizeof(buffer_size));
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(server.get_port());
+    connect(client, reinterpret_cast<struct sockaddr*>(&address),
+            sizeof(address));
+    usleep(10000);
+    server.poll();
+    // The kernel buffers grow to megabytes before the sends stall
+    for (int i = 0; i < 10000 && server.get_backlog() == 0; i++) {
+      for (int j = 0; j < 100; j++) {
+        server.write(kSentence);
+      }
+      server.poll();
+    }
+    mid_sentence = server.get_backlog() % sentence_length != 0;
+  }
+  TEST_ASSERT_TRUE(mid_sentence);
+
+  // Lap the client
+  unsigned int skips = server.get_skip_count();
+  for (size_t i = 0; i < kSentenceRingSize / sentence_length + 10; i++) {
+    server.write(kSentence);
+  }
+  server.poll();
+  TEST_ASSERT_EQUAL_UINT32(skips + 1, server.get_skip_count());
+
+  // Read everything, polling the server as the client makes room
+  std::string received;
+  char buffer[512];
+  for (int idle = 0; idle < 50;) {
+    server.poll();
+    ssize_t n = recv(client, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0) {
+      received.append(buffer, n);
+      idle = 0;
+    } else {
+      usleep(1000);
+      idle++;
+    }
+  }
+  TEST_ASSERT_EQUAL_INT(0, server.get_backlog());
+
+  // Every line is a whole sentence or the start of one
+  size_t cut_lines = 0;
+  size_t start = 0;
+  size_t end;
+  while ((end = received.find("\r\n", start)) != std::string::npos) {
+    std::string line = received.substr(start, end - start);
+    TEST_ASSERT_EQUAL_INT(0, strncmp(line.c_str(), kSentence, line.size()));
+    if (line.size() < strlen(kSentence)) {
+      cut_lines++;
+    }
+    start = end + 2;
+  }
+  TEST_ASSERT_EQUAL_INT(received.size(), start);
+  TEST_ASSERT_EQUAL_INT(1, cut_lines);
+  close(client);
+}
+#endif
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  // The socket tests use a loopback connection and run on the host only
+  RUN_TEST(test_ring_overwrites_oldest);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_ring_overwrites_oldest);
+  RUN_TEST(test_fan_out_to_clients);
+  RUN_TEST(test_slow_client_policy);
+  RUN_TEST(test_skip_ends_partial_sentence);
+
+  return UNITY_END();
+}
+#endif
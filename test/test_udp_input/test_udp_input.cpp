@@ -0,0 +1,106 @@
+#include <unity.h>
+
+#include "sensesp.h"
+#include "sensesp_nmea0183/io/udp_input.h"
+#include "sensesp_nmea0183/sentence_parser/navigation_sentence_parser.h"
+
+#ifndef ARDUINO
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// Lines of a packet are filtered and passed on in place.
+void test_framer_feeds_packet(void) {
+  NMEA0183Parser parser;
+  HDTSentenceParser hdt(&parser);
+  const char* last_sentence = nullptr;
+  SentenceFramer framer(
+      [&](const char* sentence) {
+        last_sentence = sentence;
+        parser.parse(sentence);
+      },
+      [&](const char* address, size_t length) {
+        return parser.accepts_address(address, length);
+      });
+
+  char packet[128] =
+      "$HCHDM,101.1,M*28\r\n"
+      "garbage$HCHDT,98.3,T*1B\r\n"
+      "\r\n"
+      "$HCHDT,98.3,T*1B";
+  framer.feed_packet(packet, strlen(packet));
+  TEST_ASSERT_EQUAL_INT(2, hdt.get_rx_count());
+  TEST_ASSERT_EQUAL_UINT32(2, framer.get_accepted_count());
+  TEST_ASSERT_EQUAL_UINT32(1, framer.get_rejected_count());
+  // The last sentence was passed on from the packet itself
+  TEST_ASSERT_TRUE(last_sentence >= packet &&
+                   last_sentence < packet + sizeof(packet));
+}
+
+#ifndef ARDUINO
+// Datagrams sent to the input are parsed, several per receive call.
+void test_udp_loopback(void) {
+  auto* input = new NMEA0183UDPInput(0);
+  auto* hdt = new HDTSentenceParser(&input->parser_);
+  TEST_ASSERT_TRUE(input->start(false));
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  struct sockaddr_in address = {};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(input->get_port());
+  const char* datagrams[] = {
+      "$HCHDT,98.3,T*1B\r\n$HCHDM,101.1,M*28\r\n",
+      "$HCHDT,98.3,T*1B\r\n",
+      "$HCHDT,98.3,T*1B",
+  };
+  for (const char* datagram : datagrams) {
+    sendto(fd, datagram, strlen(datagram), 0,
+           reinterpret_cast<struct sockaddr*>(&address), sizeof(address));
+  }
+  usleep(10000);
+  input->poll();
+
+  TEST_ASSERT_EQUAL_UINT32(3, input->get_datagram_count());
+  TEST_ASSERT_EQUAL_INT(3, hdt->get_rx_count());
+  TEST_ASSERT_EQUAL_UINT32(1, input->framer_.get_rejected_count());
+#ifdef __linux__
+  TEST_ASSERT_EQUAL_UINT32(1, input->get_receive_count());
+#endif
+  close(fd);
+  delete hdt;
+  delete input;
+}
+#endif
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  // The socket test uses a loopback connection and runs on the host only
+  RUN_TEST(test_framer_feeds_packet);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_framer_feeds_packet);
+  RUN_TEST(test_udp_loopback);
+
+  return UNITY_END();
+}
+#endif
@@ -84,6 +84,13 @@ void test_wpl_valid(void) {
   TEST_ASSERT_EQUAL_STRING("003", wpl->waypoint_id_.get().c_str());
 }
 
+// An ID longer than WaypointID can hold rejects the sentence.
+void test_wpl_id_too_long(void) {
+  parser->set("$GPWPL,4917.16,N,12310.64,W,WAYPOINT_ID_TOO_LONG_X*5E");
+
+  TEST_ASSERT_EQUAL_INT(0, wpl->get_rx_count());
+}
+
 #ifdef ARDUINO
 void setup() {
   delay(2000);
@@ -93,6 +100,7 @@ void setup() {
   RUN_TEST(test_apb_valid);
   RUN_TEST(test_bwc_valid);
   RUN_TEST(test_wpl_valid);
+  RUN_TEST(test_wpl_id_too_long);
 
   UNITY_END();
 }
@@ -106,6 +114,7 @@ int main(int argc, char** argv) {
   RUN_TEST(test_apb_valid);
   RUN_TEST(test_bwc_valid);
   RUN_TEST(test_wpl_valid);
+  RUN_TEST(test_wpl_id_too_long);
 
   return UNITY_END();
 }
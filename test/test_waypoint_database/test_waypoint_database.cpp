@@ -0,0 +1,120 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/data/waypoint_database.h"
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/wiring.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static NMEA0183Parser* parser;
+static WaypointDatabase* database;
+static WaypointData* waypoint_data;
+static int route_count = 0;
+
+void setUp(void) {
+  parser = new NMEA0183Parser();
+  database = new WaypointDatabase();
+  waypoint_data = new WaypointData();
+  ConnectWaypoint(parser, waypoint_data, {}, database);
+  route_count = 0;
+  waypoint_data->route.attach([]() { route_count++; });
+}
+
+void tearDown(void) {
+  delete waypoint_data;
+  delete database;
+  delete parser;
+}
+
+// The database holds kMaxWaypoints IDs and then rejects new ones.
+void test_database_capacity(void) {
+  char id[8];
+  for (int i = 0; i < (int)kMaxWaypoints; i++) {
+    snprintf(id, sizeof(id), "WP%d", i);
+    TEST_ASSERT_TRUE(database->set_position(id, i, -i));
+  }
+  TEST_ASSERT_EQUAL_UINT32(kMaxWaypoints, database->size());
+  TEST_ASSERT_FALSE(database->set_position("EXTRA", 0, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, database->get_rejected_count());
+
+  for (int i = 0; i < (int)kMaxWaypoints; i++) {
+    snprintf(id, sizeof(id), "WP%d", i);
+    int index = database->find(id);
+    TEST_ASSERT_EQUAL_INT(i, index);
+    RoutePoint point = database->get(index);
+    TEST_ASSERT_EQUAL_STRING(id, point.id.c_str());
+    TEST_ASSERT_EQUAL_FLOAT(i, point.latitude);
+  }
+  TEST_ASSERT_EQUAL_INT(-1, database->find("EXTRA"));
+
+  // Updating a known waypoint still works when full
+  TEST_ASSERT_TRUE(database->set_position("WP3", 1, 1));
+}
+
+void test_route_resolution(void) {
+  parser->set("$GPWPL,6010.000,N,02500.000,E,HOME*44");
+  parser->set("$GPWPL,6012.000,N,02506.000,E,BUOY1*7F");
+  parser->set("$GPRTE,1,1,c,R1,HOME,BUOY1,ISLE*54");
+
+  TEST_ASSERT_EQUAL_INT(1, route_count);
+  const Route& route = *waypoint_data->route.get();
+  TEST_ASSERT_EQUAL_STRING("R1", route.id.c_str());
+  TEST_ASSERT_EQUAL_INT(3, (int)route.size);
+  TEST_ASSERT_EQUAL_STRING("BUOY1", route.points[1].id.c_str());
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 60.2, route.points[1].latitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 25.1, route.points[1].longitude);
+  // ISLE is not known yet
+  TEST_ASSERT_FALSE(route.points[2].resolved());
+  TEST_ASSERT_FALSE(route.resolved());
+
+  // A new waypoint of the route resolves it
+  parser->set("$GPWPL,6015.000,N,02510.000,E,ISLE*5C");
+  TEST_ASSERT_EQUAL_INT(2, route_count);
+  TEST_ASSERT_TRUE(waypoint_data->route.get()->resolved());
+}
+
+// Routes are emitted only when they or their waypoints change.
+void test_route_emitted_on_change(void) {
+  parser->set("$GPWPL,6010.000,N,02500.000,E,HOME*44");
+  parser->set("$GPWPL,6012.000,N,02506.000,E,BUOY1*7F");
+  parser->set("$GPWPL,6015.000,N,02510.000,E,ISLE*5C");
+  parser->set("$GPRTE,1,1,c,R1,HOME,BUOY1,ISLE*54");
+  TEST_ASSERT_EQUAL_INT(1, route_count);
+
+  // The same route and waypoints again
+  parser->set("$GPRTE,1,1,c,R1,HOME,BUOY1,ISLE*54");
+  parser->set("$GPWPL,6012.000,N,02506.000,E,BUOY1*7F");
+  TEST_ASSERT_EQUAL_INT(1, route_count);
+
+  // A waypoint moves
+  parser->set("$GPWPL,6012.500,N,02506.000,E,BUOY1*7A");
+  TEST_ASSERT_EQUAL_INT(2, route_count);
+  TEST_ASSERT_FLOAT_WITHIN(0.0001, 60.208333,
+                           waypoint_data->route.get()->points[1].latitude);
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_database_capacity);
+  RUN_TEST(test_route_resolution);
+  RUN_TEST(test_route_emitted_on_change);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_database_capacity);
+  RUN_TEST(test_route_resolution);
+  RUN_TEST(test_route_emitted_on_change);
+
+  return UNITY_END();
+}
+#endif
@@ -0,0 +1,101 @@
+#include <unity.h>
+
+#include "sensesp_nmea0183/nmea0183.h"
+#include "sensesp_nmea0183/sentence_parser/navigation_sentence_parser.h"
+#include "sensesp_nmea0183/wiring.h"
+#include "sensesp_nmea0183/wiring_arena.h"
+
+using namespace sensesp;
+using namespace sensesp::nmea0183;
+
+static NMEA0183Parser* parser;
+static HeadingData* heading_data;
+
+void setUp(void) {
+  parser = new NMEA0183Parser();
+  heading_data = new HeadingData();
+}
+
+// Objects wired into arenas are never destroyed, so the parser and the data
+// are leaked as well
+void tearDown(void) {}
+
+static size_t MeasureHeading() {
+  WiringArena measure;
+  auto* measure_parser = new NMEA0183Parser();
+  auto* measure_data = new HeadingData();
+  TEST_ASSERT_FALSE(measure.wire(
+      "Heading", [&]() { ConnectHeading(measure_parser, measure_data); }));
+  TEST_ASSERT_EQUAL_UINT32(0, measure.get_used());
+  TEST_ASSERT_EQUAL_UINT32(0, measure.get_object_count());
+  return measure.get_required();
+}
+
+void test_arena_measures(void) {
+  size_t required = MeasureHeading();
+  // Two parsers and two outputs at least
+  TEST_ASSERT_TRUE(required >=
+                   sizeof(HDMSentenceParser) + sizeof(HDTSentenceParser) +
+                       2 * sizeof(SKOutputFloat));
+  TEST_ASSERT_EQUAL_UINT32(required, MeasureHeading());
+}
+
+void test_arena_holds_wiring(void) {
+  static StaticWiringArena<8192> arena;
+  size_t required = MeasureHeading();
+  TEST_ASSERT_TRUE(required <= arena.get_capacity());
+
+  TEST_ASSERT_TRUE(
+      arena.wire("Heading", [&]() { ConnectHeading(parser, heading_data); }));
+  TEST_ASSERT_EQUAL_UINT32(required, arena.get_required());
+  TEST_ASSERT_EQUAL_UINT32(required, arena.get_used());
+  TEST_ASSERT_EQUAL_UINT32(0, arena.get_overflow_count());
+  // Two parsers, two lazy outputs and the outputs they created right away
+  TEST_ASSERT_EQUAL_INT(6, arena.get_object_count());
+  TEST_ASSERT_NULL(WiringArena::active());
+
+  parser->set("$HCHDT,98.3,T*1B");
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 98.3 * DEG_TO_RAD,
+                           heading_data->true_heading.get());
+}
+
+void test_arena_overflows_to_heap(void) {
+  static uint8_t buffer[256];
+  WiringArena* arena = new WiringArena(buffer, sizeof(buffer));
+  size_t required = MeasureHeading();
+
+  TEST_ASSERT_FALSE(
+      arena->wire("Heading", [&]() { ConnectHeading(parser, heading_data); }));
+  TEST_ASSERT_EQUAL_UINT32(required, arena->get_required());
+  TEST_ASSERT_TRUE(arena->get_used() <= sizeof(buffer));
+  TEST_ASSERT_TRUE(arena->get_overflow_count() > 0);
+
+  parser->set("$HCHDT,98.3,T*1B");
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 98.3 * DEG_TO_RAD,
+                           heading_data->true_heading.get());
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000);
+  UNITY_BEGIN();
+
+  RUN_TEST(test_arena_measures);
+  RUN_TEST(test_arena_holds_wiring);
+  RUN_TEST(test_arena_overflows_to_heap);
+
+  UNITY_END();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+
+  RUN_TEST(test_arena_measures);
+  RUN_TEST(test_arena_holds_wiring);
+  RUN_TEST(test_arena_overflows_to_heap);
+
+  return UNITY_END();
+}
+#endif